@@ -0,0 +1,141 @@
+#ifndef __ARENA_H
+#define __ARENA_H
+
+#include <vector>
+#include <new>
+#include <cstddef>
+
+/** \brief Slab allocator for objects of one type.
+ *
+ * The Graph uses an Arena for its States and for its Transitions: the
+ * memory is requested in large slabs, and each object just takes the next
+ * free slot of the current slab. Objects that are released are kept in a
+ * free-list and their slots are reused by the next allocations. All slabs
+ * are freed at once when the Arena is destroyed (or cleared), without
+ * calling the destructors of the objects that are still alive.
+ *
+ * Usage: <tt>T* object = new (arena.allocate()) T(...);</tt>
+ */
+template <class T>
+class Arena {
+  public:
+    /** \brief Constructor
+     *
+     * @param slabSize Number of objects that fit into one slab
+     */
+    Arena(const unsigned int &slabSize = 4096)
+      : slabSize(slabSize), used(0), capacity(0), reserved(0),
+        freeList(NULL)
+    {
+    }
+
+    /// Destructor, frees all slabs (see clear())
+    ~Arena()
+    {
+      clear();
+    }
+
+    /** \brief Returns uninitialized memory for one object of type T
+     *
+     * The slots reserved by reserve() are used first, then the released
+     * slots of the free-list.
+     */
+    void* allocate()
+    {
+      if (reserved > 0)
+        --reserved;
+      else if (freeList != NULL) {
+        void* slot = freeList;
+        freeList = *static_cast<void**>(freeList);
+        return slot;
+      }
+      if (used == capacity)
+        newSlab(slabSize);
+      return slabs.back() + (used++) * slotSize();
+    }
+
+    /** \brief Make room for the given number of objects
+     *
+     * If the last slab has less free slots, a new slab is created that is
+     * large enough, so the next `number` objects are allocated in one
+     * contiguous block. These allocations don't take released slots from
+     * the free-list.
+     */
+    void reserve(const unsigned int &number)
+    {
+      if (capacity - used < number)
+        newSlab(number > slabSize ? number : slabSize);
+      reserved = number;
+    }
+
+    /** \brief Destroy the given object and put its slot into the free-list
+     *
+     * The object may also have been allocated by another Arena (e.g. the
+     * Graph and its threads each allocate Transitions from their own Arena,
+     * and release them into any of them). Its slot then stays in a slab of
+     * the other Arena, so the other Arena must not be cleared or destroyed
+     * before this one, otherwise the free-list points to freed memory.
+     */
+    void release(T *const &object)
+    {
+      if (object == NULL)
+        return;
+      object->~T();
+      void* slot = object;
+      *static_cast<void**>(slot) = freeList;
+      freeList = slot;
+    }
+
+    /** \brief Free all slabs at once
+     *
+     * The destructors of the objects that are still alive are NOT called, so
+     * all memory owned by these objects has to be freed before.
+     */
+    void clear()
+    {
+      for (std::vector<char*>::const_iterator slab = slabs.begin();
+          slab != slabs.end(); ++slab)
+        ::operator delete(*slab);
+      slabs.clear();
+      used = capacity = reserved = 0;
+      freeList = NULL;
+    }
+
+  private:
+    // not copyable
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+    // size of one slot, large enough for an object or a free-list pointer
+    static std::size_t slotSize()
+    {
+      return (sizeof(T) < sizeof(void*)) ? sizeof(void*) : sizeof(T);
+    }
+
+    // appends a slab with the given number of slots
+    void newSlab(const unsigned int &slots)
+    {
+      slabs.push_back(static_cast<char*>(::operator new(slots * slotSize())));
+      used = 0;
+      capacity = slots;
+    }
+
+    // number of objects per slab
+    unsigned int slabSize;
+
+    // number of used and of all slots in the last slab
+    unsigned int used;
+    unsigned int capacity;
+
+    // number of slots reserved by reserve() that are not allocated yet
+    unsigned int reserved;
+
+    // first released slot, each released slot points to the next one
+    void* freeList;
+
+    // all slabs
+    std::vector<char*> slabs;
+
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "ClosureContext.h"
+#include <cstddef>
+
+void ClosureContext::clearSuccessors()
+{
+  noSuccessors = 0;
+  if (successors.empty()) {
+    const Successor unused = { NULL, NULL, NULL, 0 };
+    successors.assign(16, unused);
+  }
+  // a new stamp frees all buckets at once
+  if (++stamp == 0) {
+    for (std::vector<Successor>::iterator it = successors.begin();
+        it != successors.end(); ++it)
+      it->stamp = 0;
+    stamp = 1;
+  }
+}
+
+bool ClosureContext::addSuccessor(State *const &target, Label *const &label,
+    Label *const &tail)
+{
+  // linear probing
+  const unsigned int mask = successors.size() - 1;
+  unsigned int bucket = hash(target, label, tail) & mask;
+  for (; successors[bucket].stamp == stamp; bucket = (bucket + 1) & mask)
+    if ((successors[bucket].target == target)
+        && (successors[bucket].label == label)
+        && (successors[bucket].tail == tail))
+      return false;
+
+  Successor &successor = successors[bucket];
+  successor.target = target;
+  successor.label = label;
+  successor.tail = tail;
+  successor.stamp = stamp;
+
+  // keep the load factor below 1/2
+  if (2 * ++noSuccessors > successors.size()) {
+    const Successor unused = { NULL, NULL, NULL, 0 };
+    std::vector<Successor> old(2 * successors.size(), unused);
+    old.swap(successors);
+    const unsigned int newMask = successors.size() - 1;
+    for (std::vector<Successor>::const_iterator it = old.begin();
+        it != old.end(); ++it) {
+      if (it->stamp != stamp)
+        continue;
+      unsigned int b = hash(it->target, it->label, it->tail) & newMask;
+      while (successors[b].stamp == stamp)
+        b = (b + 1) & newMask;
+      successors[b] = *it;
+    }
+  }
+  return true;
+}
+
+Transition* ClosureContext::newSuccessor(State *const &target,
+    Label *const &head, Label *const &tail)
+{
+  Label* label = (tail == NULL) ? head : labels.findPath(head, tail);
+
+  // a LabelPath that doesn't exist yet is known by its head and tail
+  if (!((label != NULL) ? addSuccessor(target, label)
+        : addSuccessor(target, head, tail)))
+    return NULL;
+
+  Transition* transition = newTransition(target, label);
+  if (label == NULL) {
+    PendingLabel pendingLabel;
+    pendingLabel.transition = transition;
+    pendingLabel.head = head;
+    pendingLabel.tail = tail;
+    pending.push_back(pendingLabel);
+  }
+  return transition;
+}
+
+unsigned int ClosureContext::hash(const State *const &target,
+    const Label *const &label, const Label *const &tail)
+{
+  unsigned int h = static_cast<unsigned int>(
+      reinterpret_cast<std::size_t>(target) >> 3);
+  h = h * 31 + label->getId();
+  if (tail != NULL)
+    h = h * 31 + tail->getId();
+  // spread the bits, the low ones select the bucket
+  h ^= h >> 16;
+  h *= 0x45d9f3bu;
+  h ^= h >> 16;
+  return h;
+}
@@ -0,0 +1,148 @@
+#ifndef __CLOSURECONTEXT_H
+#define __CLOSURECONTEXT_H
+
+#include <vector>
+#include "Arena.h"
+#include "Transition.h"
+#include "LabelTable.h"
+
+/** \brief Everything State::getMarkovSuccs() needs to create Transitions.
+ *
+ * The markov successors of independent States are computed concurrently
+ * (see Graph::transformImcToCtmdp()), so the Transitions are created in an
+ * Arena of the executing thread, and the LabelTable of the Graph is only
+ * read: if a LabelPath doesn't exist yet, the new Transition gets no Label
+ * at first, and the Transition is stored as a PendingLabel. The Graph
+ * creates the missing LabelPaths afterwards, in a deterministic order.
+ *
+ * It also remembers the markov successors of the current State, so several
+ * paths to the same markov State with the same Label only yield one
+ * Transition.
+ */
+class ClosureContext {
+  public:
+
+    /// A Transition that still needs a LabelPath
+    struct PendingLabel {
+      /// The Transition
+      Transition* transition;
+      /// The head of its LabelPath
+      Label* head;
+      /// The tail of its LabelPath
+      Label* tail;
+    };
+
+    /** \brief Constructor
+     *
+     * @param arena         The Arena for the new Transitions (and the deleted
+     *                      ones)
+     * @param labels        The LabelTable of the Graph, it is only read
+     * @param dfsLabel      The Label for the Transitions if no labels are
+     *                      computed
+     * @param computeLabels Compute the labels to the markov successors? (see
+     *                      Graph::transformImcToCtmdp())
+     * @param pending       Here the Transitions that still need a LabelPath
+     *                      are appended
+     */
+    ClosureContext(Arena<Transition> &arena, const LabelTable &labels,
+        Label *const &dfsLabel, const bool &computeLabels,
+        std::vector<PendingLabel> &pending)
+      : arena(arena), labels(labels), dfsLabel(dfsLabel),
+        computeLabels(computeLabels), pending(pending), noSuccessors(0),
+        stamp(0)
+    {
+    }
+
+    /// Should the labels to the markov successors be computed?
+    bool getComputeLabels() const {
+      return computeLabels;
+    }
+
+    /// Returns the Label for the Transitions if no labels are computed
+    Label* getDfsLabel() const {
+      return dfsLabel;
+    }
+
+    /// Create a new Transition
+    Transition* newTransition(State *const &target, Label *const &label) {
+      return new (arena.allocate()) Transition(target, label);
+    }
+
+    /// Create a copy of a Transition
+    Transition* newTransition(const Transition &transition) {
+      return new (arena.allocate()) Transition(transition);
+    }
+
+    /** \brief Delete a Transition (see Graph::deleteTransition())
+     *
+     * The Transition may have been created by another Arena of the Graph
+     * (e.g. while reading the input), its slot is put into the free-list of
+     * this Arena anyway. This is allowed, as all Arenas of a Graph live as
+     * long as the Graph (see Arena::release()).
+     */
+    void deleteTransition(Transition *const &transition) {
+      arena.release(transition);
+    }
+
+    /** \brief Forget the markov successors added so far
+     *
+     * Called before the markov successors of the next State are collected
+     * (see addSuccessor()).
+     */
+    void clearSuccessors();
+
+    /** \brief Add a markov successor of the current State
+     *
+     * A Label that is a LabelPath which doesn't exist yet is given by its
+     * head (as `label`) and its tail, otherwise `tail` is NULL.
+     *
+     * @return false, if a Transition to the target with the same Label has
+     *         already been added since clearSuccessors()
+     */
+    bool addSuccessor(State *const &target, Label *const &label,
+        Label *const &tail = NULL);
+
+    /** \brief Create a new Transition to a markov successor
+     *
+     * Its Label is the LabelPath of head and tail, or head if tail is NULL.
+     * If the LabelPath doesn't exist yet, the Transition gets no Label at
+     * first, and it is appended to the PendingLabels.
+     *
+     * @return the new Transition, or NULL if there already is a Transition
+     *         to the target with the same Label (see addSuccessor())
+     */
+    Transition* newSuccessor(State *const &target, Label *const &head,
+        Label *const &tail);
+
+  private:
+
+    Arena<Transition> &arena;
+
+    const LabelTable &labels;
+
+    Label* dfsLabel;
+
+    bool computeLabels;
+
+    std::vector<PendingLabel> &pending;
+
+    // a markov successor, see addSuccessor()
+    struct Successor {
+      State* target;
+      Label* label;
+      Label* tail;
+      // the bucket is used iff stamp is the current stamp
+      unsigned int stamp;
+    };
+
+    // the markov successors added since clearSuccessors(), in an
+    // open-addressing hash table
+    std::vector<Successor> successors;
+    unsigned int noSuccessors, stamp;
+
+    static unsigned int hash(const State *const &target,
+        const Label *const &label, const Label *const &tail);
+
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "CycleDetector.h"
+#include <algorithm>
+#include <cassert>
+
+CycleDetector::CycleDetector(const unsigned int &noNodes)
+  : position(noNodes), succs(noNodes), preds(noNodes), visited(noNodes, false)
+{
+  // the initial topological order is the order of the node numbers
+  for (unsigned int node = 0; node < noNodes; ++node)
+    position[node] = node;
+}
+
+CycleDetector::~CycleDetector()
+{
+  // nothing to do
+}
+
+bool CycleDetector::insertEdge(const unsigned int &from,
+    const unsigned int &to)
+{
+  assert(from < position.size());
+  assert(to < position.size());
+
+  if (from == to)
+    return false;
+
+  const unsigned int lowerBound = position[to],
+                     upperBound = position[from];
+
+  // only if the edge violates the topological order, there is work to do
+  if (lowerBound < upperBound) {
+    if (!searchForward(to, upperBound)) {
+      // the edge would close a cycle
+      for (std::vector<unsigned int>::const_iterator node =
+          deltaForward.begin(); node != deltaForward.end(); ++node)
+        visited[*node] = false;
+      deltaForward.clear();
+      return false;
+    }
+    searchBackward(from, lowerBound);
+    reorder();
+  }
+
+  succs[from].push_back(to);
+  preds[to].push_back(from);
+  return true;
+}
+
+bool CycleDetector::searchForward(const unsigned int &start,
+    const unsigned int &upperBound)
+{
+  stack.push_back(start);
+  visited[start] = true;
+  deltaForward.push_back(start);
+  while (!stack.empty()) {
+    const unsigned int node = stack.back();
+    stack.pop_back();
+    for (std::vector<unsigned int>::const_iterator succ = succs[node].begin();
+        succ != succs[node].end(); ++succ) {
+      if (position[*succ] == upperBound) {
+        stack.clear();
+        return false;
+      }
+      if (!visited[*succ] && (position[*succ] < upperBound)) {
+        visited[*succ] = true;
+        deltaForward.push_back(*succ);
+        stack.push_back(*succ);
+      }
+    }
+  }
+  return true;
+}
+
+void CycleDetector::searchBackward(const unsigned int &start,
+    const unsigned int &lowerBound)
+{
+  stack.push_back(start);
+  visited[start] = true;
+  deltaBackward.push_back(start);
+  while (!stack.empty()) {
+    const unsigned int node = stack.back();
+    stack.pop_back();
+    for (std::vector<unsigned int>::const_iterator pred = preds[node].begin();
+        pred != preds[node].end(); ++pred)
+      if (!visited[*pred] && (position[*pred] > lowerBound)) {
+        visited[*pred] = true;
+        deltaBackward.push_back(*pred);
+        stack.push_back(*pred);
+      }
+  }
+}
+
+void CycleDetector::reorder()
+{
+  sortByPosition(deltaForward);
+  sortByPosition(deltaBackward);
+
+  // the positions that are reassigned
+  std::vector<unsigned int> positions;
+  positions.reserve(deltaForward.size() + deltaBackward.size());
+  for (std::vector<unsigned int>::const_iterator node = deltaBackward.begin();
+      node != deltaBackward.end(); ++node)
+    positions.push_back(position[*node]);
+  for (std::vector<unsigned int>::const_iterator node = deltaForward.begin();
+      node != deltaForward.end(); ++node)
+    positions.push_back(position[*node]);
+  std::inplace_merge(positions.begin(),
+      positions.begin() + deltaBackward.size(), positions.end());
+
+  // first the nodes reaching the source, then the nodes reached from the
+  // target of the new edge
+  std::vector<unsigned int>::const_iterator nextPosition = positions.begin();
+  for (std::vector<unsigned int>::const_iterator node = deltaBackward.begin();
+      node != deltaBackward.end(); ++node) {
+    position[*node] = *nextPosition++;
+    visited[*node] = false;
+  }
+  for (std::vector<unsigned int>::const_iterator node = deltaForward.begin();
+      node != deltaForward.end(); ++node) {
+    position[*node] = *nextPosition++;
+    visited[*node] = false;
+  }
+
+  deltaForward.clear();
+  deltaBackward.clear();
+}
+
+// needed for CycleDetector::sortByPosition()
+struct _CycleDetectorComparePosition {
+  const std::vector<unsigned int> &position;
+  _CycleDetectorComparePosition(const std::vector<unsigned int> &p)
+    : position(p) {}
+  bool operator() (const unsigned int &n1, const unsigned int &n2) const {
+    return position[n1] < position[n2];
+  }
+};
+
+void CycleDetector::sortByPosition(std::vector<unsigned int> &nodes) const
+{
+  std::sort(nodes.begin(), nodes.end(),
+      _CycleDetectorComparePosition(position));
+}
@@ -0,0 +1,79 @@
+#ifndef __CYCLEDETECTOR_H
+#define __CYCLEDETECTOR_H
+
+#include <vector>
+
+/** \brief Online cycle detection for a growing directed graph.
+ *
+ * The GraphInput classes use this class to find the interactive Transitions
+ * that would close an interactive cycle while the Graph is read. The nodes
+ * are the indices of the States, and only the interactive Transitions are
+ * inserted as edges.
+ *
+ * The algorithm is the dynamic topological sort of Pearce and Kelly ("A
+ * Dynamic Topological Sort Algorithm for Directed Acyclic Graphs", 2006):
+ * A topological order of the (acyclic) graph is maintained. Inserting an
+ * edge that agrees with the order costs constant time. Otherwise only the
+ * nodes whose position lies between the positions of the two end points
+ * of the edge are searched and reordered. Hence, building the graph costs
+ * nearly linear time in practice, instead of one full search per edge.
+ */
+class CycleDetector {
+  public:
+    /// Constructor for a graph with the given number of nodes and no edges
+    CycleDetector(const unsigned int &noNodes = 0);
+
+    /// Destructor
+    ~CycleDetector();
+
+    /** \brief Try to insert an edge.
+     *
+     * The edge is inserted iff it doesn't close a cycle, i.e. iff there is
+     * no path from `to` to `from` (a self-loop always closes a cycle).
+     * Otherwise the graph is left unchanged.
+     *
+     * @param from The source node of the edge
+     * @param to   The target node of the edge
+     *
+     * @return true, if the edge has been inserted, false if it would have
+     *         closed a cycle
+     */
+    bool insertEdge(const unsigned int &from, const unsigned int &to);
+
+  private:
+
+    // search the nodes reachable from `start` with a position lower than
+    // upperBound, and collect them in deltaForward
+    // returns false, if a node at position upperBound is reached (i.e. a
+    // cycle would be closed)
+    bool searchForward(const unsigned int &start,
+        const unsigned int &upperBound);
+
+    // search the nodes reaching `start` with a position higher than
+    // lowerBound, and collect them in deltaBackward
+    void searchBackward(const unsigned int &start,
+        const unsigned int &lowerBound);
+
+    // reassign the positions of the nodes in deltaForward and deltaBackward,
+    // such that all of deltaBackward are placed in front of deltaForward
+    void reorder();
+
+    // sorts the nodes by their position
+    void sortByPosition(std::vector<unsigned int> &nodes) const;
+
+    // position of each node in the topological order
+    std::vector<unsigned int> position;
+
+    // successors and predecessors of each node
+    std::vector< std::vector<unsigned int> > succs, preds;
+
+    // nodes visited by the last search, and the flags for them
+    std::vector<unsigned int> deltaForward, deltaBackward;
+    std::vector<bool> visited;
+
+    // stack of the iterative searches
+    std::vector<unsigned int> stack;
+
+};
+
+#endif
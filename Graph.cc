@@ -17,35 +17,50 @@
 #include "Label.h"
 #include "GraphInput.h"
 #include "GraphOutput.h"
+#include "GraphCSR.h"
+#include "GraphStatistics.h"
+#include "GraphBisimulation.h"
+#include "CycleDetector.h"
+#include "ClosureContext.h"
+#include "ThreadPool.h"
 
 // static class members
 bool Graph::cycleSearch = true;
+bool Graph::deferredCycleSearch = false;
+unsigned int Graph::threads = 1;
 bool Graph::searchForAbsorbingStates = false;
+std::vector<std::string> Graph::labPropositions;
 char* Graph::colorDebug   = "\033[32m";
 char* Graph::colorWarning = "\033[31m";
 char* Graph::colorReset   = "\033[0m";
 std::string Graph::theAction;
-std::map<std::string, Label*> Graph::labels;
 const double Graph::uniformEpsilon = 1e-8;
 
 Graph::Graph()
-  : initialState(NULL), readyForExport(false)
+  : csr(new GraphCSR()), csrValid(false),
+    statistics(new GraphStatistics()), statisticsValid(false),
+    initialState(NULL),
+    readyForExport(false)
 {
 }
 
 Graph::~Graph()
 {
-  // delete all states
+  // destroy all states, their memory and the memory of the Transitions is
+  // freed together with the Arenas
   for (std::vector<State*>::const_iterator it = states.begin();
       it != states.end(); ++it)
-    delete *it;
+    if (*it != NULL)
+      (*it)->~State();
   states.clear();
+  for (std::vector<Arena<Transition>*>::const_iterator it =
+      workerArenas.begin(); it != workerArenas.end(); ++it)
+    delete *it;
+  workerArenas.clear();
+  delete csr;
+  delete statistics;
   initialState = NULL;
-  // delete labels
-  for (std::map<std::string, Label*>::const_iterator it =
-      labels.begin(); it != labels.end(); ++it)
-    delete it->second;
-  labels.clear();
+  // the Labels are deleted by the LabelTable
 }
 
 Graph* Graph::read(const std::string &format, const std::string &filename)
@@ -82,52 +97,37 @@ void Graph::write(const std::string &format, const std::string &filename)
 
 void Graph::transformImcToCtmdp(const bool &computeLabels)
 {
-  // for statistics
-  unsigned int imcInteractive(0), imcMarkov(0), imcHybrid(0), imcDeadlock(0),
-               imcITrans(0), imcMTrans(0),
-               ctmdpInteractive(0), ctmdpMarkov(0), ctmdpDeadlock(0),
-               ctmdpITrans(0), ctmdpMTrans(0),
-               ctmdpMaxNondet(0), ctmdpMaxFanout(0);
+  // statistics of the IMC, collected while reading it if it hasn't been
+  // modified since
+  GraphStatistics imc;
+  imc.assignNumbers(getStatistics());
+
+  // the hybrid States become interactive ones, and the indices of the
+  // States are needed below (see State::getIndex())
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state) {
+    states[state]->setIndex(state);
+    if (states[state]->getType() == State::HYBRID)
+      states[state]->setType(State::INTERACTIVE);
+  }
 
-  // compute statistics
-  for (std::vector<State*>::const_iterator state = states.begin();
-    state != states.end(); ++state) {
-    // add nr of interactive/markov transitions
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end();
-        ++trans)
-      if ((*trans)->isInteractive())
-        ++imcITrans;
-      else
-        ++imcMTrans;
-    switch ((*state)->getType()) {
-      case State::HYBRID:
-        (*state)->setType(State::INTERACTIVE);
-        ++imcHybrid;
-        break;
-      case State::INTERACTIVE:
-        ++imcInteractive;
-        break;
-      case State::MARKOV:
-        ++imcMarkov;
-        break;
-      default:
-        ++imcDeadlock;
-        break;
-    }
+  // the State objects are modified from now on
+  invalidateCSR();
+
+  // We compute reachable MARKOV states for each INTERACTIVE state, the
+  // successors before their predecessors.
+  {
+    std::vector<State*> closureOrder;
+    getClosureOrder(closureOrder);
+    computeMarkovSuccs(closureOrder, computeLabels);
   }
 
-  // We compute reachable MARKOV states for each INTERACTIVE state.
-  // BTW store all states with MARKOV predecessor
-  std::set<State*> hasMarkovPred;
+  // BTW store all states with MARKOV predecessor (by their index)
+  std::vector<bool> hasMarkovPred(states.size(), false);
   std::vector<State*> newStates;
   for (std::vector<State*>::const_iterator state = states.begin();
     state != states.end(); ++state) {
     switch ((*state)->getType()) {
-      case State::INTERACTIVE:
-        (*state)->getMarkovSuccs(computeLabels);
-        break;
       case State::MARKOV:
         // for each successor
         for (std::vector<Transition*>::const_iterator trans =
@@ -137,7 +137,7 @@ void Graph::transformImcToCtmdp(const bool &computeLabels)
           State* targetState = (*trans)->getTargetState();
           // if MARKOV ==> insert new interactive state
           if (targetState->getType() != State::MARKOV) {
-            hasMarkovPred.insert((*trans)->getTargetState());
+            hasMarkovPred[targetState->getIndex()] = true;
             continue;
           }
 
@@ -146,12 +146,13 @@ void Graph::transformImcToCtmdp(const bool &computeLabels)
             (*trans)->setTargetState(targetState->getInteractivePred());
           else {
             // targetState has no interactive successor so far
-            State* newState = new State();
+            State* newState = this->newState();
             newStates.push_back(newState);
             newState->setType(State::INTERACTIVE);
-            newState->addTransition(new Transition(targetState, "i"));
+            newState->addTransition(newTransition(targetState, "i"));
             if (targetState->getMark())
               newState->setMark(true);
+            newState->setOrigin(targetState->getOrigin());
             (*trans)->setTargetState(newState);
             // now the target State has an interactive predecessor
             targetState->setInteractivePred(newState);
@@ -164,14 +165,14 @@ void Graph::transformImcToCtmdp(const bool &computeLabels)
   }
 
   // Now delete all INTERACTIVE states with no MARKOV predecessor
-  for (std::vector<State*>::iterator state = states.begin();
-      state != states.end(); ++state)
-    if (((*state)->getType() == State::INTERACTIVE)
-        && (!hasMarkovPred.erase(*state))
-        && (*state != initialState))
-      delete *state;
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state)
+    if ((states[state]->getType() == State::INTERACTIVE)
+        && (!hasMarkovPred[state])
+        && (states[state] != initialState))
+      deleteState(states[state]);
     else
-      newStates.push_back(*state);
+      newStates.push_back(states[state]);
   // swap vector newStates with states
   // then clear newStates (old `states` vector)
   newStates.swap(states);
@@ -182,117 +183,769 @@ void Graph::transformImcToCtmdp(const bool &computeLabels)
   // check if initial state is MARKOV or INTERACTIVE/HYBRID
   if (initialState->getType() == State::MARKOV) {
     // if it is MARKOV create new initial state and append a transition
-    State* newState = new State();
-    newState->addTransition(new Transition(initialState, "i"));
+    State* newState = this->newState();
+    newState->addTransition(newTransition(initialState, "i"));
     newState->setType(State::INTERACTIVE);
     newState->setMark(initialState->getMark());
+    newState->setOrigin(initialState->getOrigin());
     initialState = newState;
     states.push_back(newState);
   }
 
-  // statistics after the transformation
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
-    const unsigned int noTrans = (*state)->getTransitions()->size();
+  // statistics after the transformation (kept for
+  // hasInternalNondeterminism())
+  debugTransformation(imc, getStatistics());
+}
 
-    switch ((*state)->getType()) {
-      case State::INTERACTIVE:
-        ++ctmdpInteractive;
-        ctmdpITrans += noTrans;
-        if (noTrans > ctmdpMaxNondet)
-          ctmdpMaxNondet = noTrans;
+// needed for Graph::transformReachable(): the States reached so far, and the
+// search for the markov successors of the interactive ones
+struct _GraphReachableSearch {
+  enum colour { WHITE, GREY, BLACK };
+  Graph &graph;
+  ClosureContext &context;
+  std::vector<ClosureContext::PendingLabel> &pending;
+  // the colour of each State in the search for the markov successors (see
+  // Graph::getClosureOrder()), and whether it is reached, by its index
+  std::vector<unsigned char> colours;
+  std::vector<bool> reached;
+  // the reached States, in the order they are found
+  std::vector<State*> order;
+  // the DFS stack: State and its next Transition to handle
+  std::vector< std::pair<State*, std::vector<Transition*>::size_type> >
+    dfsStack;
+
+  _GraphReachableSearch(Graph &graph, ClosureContext &context,
+      std::vector<ClosureContext::PendingLabel> &pending,
+      const unsigned int &noStates)
+    : graph(graph), context(context), pending(pending),
+      colours(noStates, WHITE), reached(noStates, false) {}
+
+  // gives a new State the next index, it has its markov successors already
+  void addState(State *const &state) {
+    state->setIndex(colours.size());
+    colours.push_back(BLACK);
+    reached.push_back(false);
+  }
+
+  void reach(State *const &state) {
+    if (reached[state->getIndex()])
+      return;
+    reached[state->getIndex()] = true;
+    order.push_back(state);
+  }
+
+  // the new interactive predecessor of the markov State, see
+  // State::getInteractivePred()
+  State* getInteractivePred(State *const &state) {
+    if (state->getInteractivePred() == NULL) {
+      State* newState = graph.newState();
+      newState->setType(State::INTERACTIVE);
+      newState->addTransition(graph.newTransition(state, "i"));
+      if (state->getMark())
+        newState->setMark(true);
+      newState->setOrigin(state->getOrigin());
+      state->setInteractivePred(newState);
+      addState(newState);
+    }
+    return state->getInteractivePred();
+  }
+
+  // computes the markov successors of the interactive State, and before
+  // those of its interactive successors (in the post-order of a DFS along
+  // the interactive Transitions, like Graph::getClosureOrder())
+  void computeMarkovSuccs(State *const &root) {
+    if (colours[root->getIndex()] != WHITE)
+      return;
+    colours[root->getIndex()] = GREY;
+    dfsStack.push_back(std::make_pair(root, 0));
+
+    while (!dfsStack.empty()) {
+      State* state = dfsStack.back().first;
+      const std::vector<Transition*> &transitions = *state->getTransitions();
+      std::vector<Transition*>::size_type &trans = dfsStack.back().second;
+
+      // search the next unvisited interactive successor
+      while ((trans < transitions.size())
+          && (!transitions[trans]->isInteractive()
+            || (transitions[trans]->getTargetState()->getType()
+              == State::MARKOV)
+            || (transitions[trans]->getTargetState()->getType()
+              == State::NOTDEC)
+            || (colours[transitions[trans]->getTargetState()->getIndex()]
+              != WHITE)))
+        ++trans;
+
+      if (trans == transitions.size()) {
+        // all successors are handled, hybrid States become interactive ones
+        colours[state->getIndex()] = BLACK;
+        state->setType(State::INTERACTIVE);
+        state->getMarkovSuccs(context);
+        for (std::vector<ClosureContext::PendingLabel>::const_iterator it =
+            pending.begin(); it != pending.end(); ++it)
+          it->transition->setLabel(graph.getPathLabelPtr(it->head,
+                it->tail));
+        pending.clear();
+        dfsStack.pop_back();
+        continue;
+      }
+
+      State* successor = transitions[trans++]->getTargetState();
+      colours[successor->getIndex()] = GREY;
+      // `trans` is invalid after this
+      dfsStack.push_back(std::make_pair(successor, 0));
+    }
+  }
+};
+
+void Graph::transformReachable(const bool &computeLabels,
+    const bool &uniformize)
+{
+  // statistics of the IMC, collected while reading it if it hasn't been
+  // modified since
+  GraphStatistics imc;
+  imc.assignNumbers(getStatistics());
+
+  // the indices of the States are needed below (see State::getIndex())
+  const unsigned int noImcStates = states.size();
+  for (std::vector<State*>::size_type state = 0; state < noImcStates;
+      ++state)
+    states[state]->setIndex(state);
+
+  // the State objects are modified from now on
+  invalidateCSR();
+
+  std::vector<ClosureContext::PendingLabel> pending;
+  ClosureContext context(transitionArena, labels, computeLabels ? NULL :
+      getLabelPtr("DFS"), computeLabels, pending);
+  _GraphReachableSearch search(*this, context, pending, noImcStates);
+
+  // a markov initial State gets a new interactive one
+  if (initialState->getType() == State::MARKOV) {
+    State* newState = this->newState();
+    newState->addTransition(newTransition(initialState, "i"));
+    newState->setType(State::INTERACTIVE);
+    newState->setMark(initialState->getMark());
+    newState->setOrigin(initialState->getOrigin());
+    search.addState(newState);
+    initialState = newState;
+  }
+  search.reach(initialState);
+
+  // breadth-first search over the CTMDP, the markov successors of an
+  // interactive State are computed when it is reached
+  std::vector<State*> markovStates;
+  std::vector<double> exitRates;
+  for (std::vector<State*>::size_type next = 0; next < search.order.size();
+      ++next) {
+    State *const state = search.order[next];
+    std::vector<Transition*> &transitions = *state->getTransitions();
+    switch (state->getType()) {
+      case State::MARKOV: {
+        // a markov successor gets an interactive predecessor
+        double exitRate = 0.0;
+        for (std::vector<Transition*>::const_iterator trans =
+            transitions.begin(); trans != transitions.end(); ++trans) {
+          exitRate += (*trans)->getLabel()->getRate();
+          State* target = (*trans)->getTargetState();
+          if (target->getType() == State::MARKOV) {
+            target = search.getInteractivePred(target);
+            (*trans)->setTargetState(target);
+          }
+          search.reach(target);
+        }
+        markovStates.push_back(state);
+        exitRates.push_back(exitRate);
         break;
-      case State::MARKOV:
-        ++ctmdpMarkov;
-        ctmdpMTrans += noTrans;
-        if (noTrans > ctmdpMaxFanout)
-          ctmdpMaxFanout = noTrans;
+      }
+      case State::NOTDEC:
         break;
       default:
-        ++ctmdpDeadlock;
-        // assure that no hybrid states exist any more
-        assert((*state)->getType() == State::NOTDEC);
+        search.computeMarkovSuccs(state);
+        for (std::vector<Transition*>::const_iterator trans =
+            transitions.begin(); trans != transitions.end(); ++trans)
+          search.reach((*trans)->getTargetState());
         break;
     }
   }
 
+  // uniformize the reached markov States (see uniformize()), the self-loops
+  // lead to their interactive predecessors
+  if (!markovStates.empty()) {
+    const double minOutgoingRate = *std::min_element(exitRates.begin(),
+        exitRates.end()),
+          maxOutgoingRate = *std::max_element(exitRates.begin(),
+              exitRates.end());
+    if (!isUniform(minOutgoingRate, maxOutgoingRate, true) && uniformize) {
+      unsigned int added = 0;
+      for (std::vector<State*>::size_type state = 0;
+          state < markovStates.size(); ++state) {
+        const double diff = (maxOutgoingRate - exitRates[state])
+          / maxOutgoingRate;
+        if (diff <= uniformEpsilon)
+          continue;
+        std::ostringstream label;
+        label << "rate " << std::setprecision(10)
+          << (maxOutgoingRate - exitRates[state]);
+        State* pred = search.getInteractivePred(markovStates[state]);
+        Transition* selfLoop = newTransition(pred, label.str());
+        markovStates[state]->addTransition(selfLoop);
+        exitRates[state] += selfLoop->getLabel()->getRate();
+        search.reach(pred);
+        added++;
+      }
+      debug("Added %d markov self-loops.", added);
+    }
+  }
+
+  // delete the States that haven't been reached
+  unsigned int deleted = 0;
+  for (std::vector<State*>::size_type state = 0; state < noImcStates;
+      ++state)
+    if (!search.reached[state]) {
+      deleteState(states[state]);
+      ++deleted;
+    }
+  debug("Deleted %d states of the IMC that are not reached.", deleted);
+
+  // number the States in the order they have been found, but the interactive
+  // ones (starting with the initial State) before the markov ones, like
+  // numberStates()
+  std::vector<State*> newStates;
+  newStates.reserve(search.order.size());
+  for (std::vector<State*>::const_iterator state = search.order.begin();
+      state != search.order.end(); ++state)
+    if ((*state)->getType() != State::MARKOV)
+      newStates.push_back(*state);
+  const unsigned int noInteractive = newStates.size();
+  newStates.insert(newStates.end(), markovStates.begin(), markovStates.end());
+  newStates.swap(states);
+  newStates.clear();
+
+  // the statistics of the CTMDP: interactive States have only interactive
+  // Transitions now, and markov States only markov ones
+  GraphStatistics ctmdp;
+  ctmdp.exitRates.assign(states.size(), 0.0);
+  std::copy(exitRates.begin(), exitRates.end(),
+      ctmdp.exitRates.begin() + noInteractive);
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state) {
+    states[state]->setNumber(state);
+    ctmdp.addState(state, states[state]->getType(),
+        states[state]->getTransitions()->size());
+  }
+  ctmdp.noInteractiveTransitions = ctmdp.noTransitions[State::INTERACTIVE];
+  ctmdp.noMarkovTransitions = ctmdp.noTransitions[State::MARKOV];
+  invalidateCSR();
+  setStatistics(ctmdp);
+  setReadyForExport(true);
+
+  debugTransformation(imc, getStatistics());
+}
+
+void Graph::debugTransformation(const GraphStatistics &imc,
+    const GraphStatistics &ctmdp) const
+{
+  // assure that no hybrid states exist any more
+  assert(ctmdp.noStates[State::HYBRID] == 0);
 
   // output the statistics
   debug("######################################################");
   const char* f = "  %-12s%20d%20d";
   debug("  %12s%20s%20s", "", "IMC statistics", "CTMDP statistics");
   debug("STATES");
-  debug(f, "Interactive", imcInteractive, ctmdpInteractive);
-  debug(f, "Markov", imcMarkov, ctmdpMarkov);
-  debug(f, "Hybrid", imcHybrid, 0);
-  debug(f, "Deadlock", imcDeadlock, ctmdpDeadlock);
+  debug(f, "Interactive", imc.noStates[State::INTERACTIVE],
+      ctmdp.noStates[State::INTERACTIVE]);
+  debug(f, "Markov", imc.noStates[State::MARKOV],
+      ctmdp.noStates[State::MARKOV]);
+  debug(f, "Hybrid", imc.noStates[State::HYBRID], 0);
+  debug(f, "Deadlock", imc.noStates[State::NOTDEC],
+      ctmdp.noStates[State::NOTDEC]);
   debug("TRANSITIONS");
-  debug(f, "Interactive", imcITrans, ctmdpITrans);
-  debug(f, "Markov", imcMTrans, ctmdpMTrans);
+  debug(f, "Interactive", imc.noInteractiveTransitions,
+      ctmdp.noTransitions[State::INTERACTIVE]);
+  debug(f, "Markov", imc.noMarkovTransitions,
+      ctmdp.noTransitions[State::MARKOV]);
   debug("CTMDP");
-  debug("  %-32s%20d", "Maximal degree of nondeterminism", ctmdpMaxNondet);
-  debug("  %-32s%20d", "Maximal fanout", ctmdpMaxFanout);
+  debug("  %-32s%20d", "Maximal degree of nondeterminism",
+      ctmdp.maxTransitions[State::INTERACTIVE]);
+  debug("  %-32s%20d", "Maximal fanout", ctmdp.maxTransitions[State::MARKOV]);
   debug("######################################################");
 }
 
+State* Graph::newState()
+{
+  return new (stateArena.allocate()) State();
+}
+
+Transition* Graph::newTransition(State *const &target, Label *const &label)
+{
+  return new (transitionArena.allocate()) Transition(target, label);
+}
+
+Transition* Graph::newTransition(State *const &target,
+    const std::string &label)
+{
+  return new (transitionArena.allocate()) Transition(target,
+      getLabelPtr(label));
+}
+
+Transition* Graph::newTransition(const Transition &transition)
+{
+  return new (transitionArena.allocate()) Transition(transition);
+}
+
+void Graph::deleteState(State *const &state)
+{
+  for (std::vector<Transition*>::const_iterator it =
+      state->getTransitions()->begin();
+      it != state->getTransitions()->end(); ++it)
+    transitionArena.release(*it);
+  stateArena.release(state);
+}
+
+void Graph::deleteTransition(Transition *const &transition)
+{
+  transitionArena.release(transition);
+}
+
+void Graph::reserveTransitions(const unsigned int &number)
+{
+  transitionArena.reserve(number);
+}
+
+void Graph::getClosureOrder(std::vector<State*> &order) const
+{
+  // post-order of an iterative DFS along the interactive Transitions
+  // between interactive States, started at each interactive State in the
+  // order of `states`
+  enum colour { WHITE, GREY, BLACK };
+  std::vector<unsigned char> colours(states.size(), WHITE);
+  // the DFS stack: State and its next Transition to handle
+  std::vector< std::pair<State*, std::vector<Transition*>::size_type> >
+    dfsStack;
+
+  order.clear();
+  for (std::vector<State*>::const_iterator root = states.begin();
+      root != states.end(); ++root) {
+    if (((*root)->getType() != State::INTERACTIVE)
+        || (colours[(*root)->getIndex()] != WHITE))
+      continue;
+    colours[(*root)->getIndex()] = GREY;
+    dfsStack.push_back(std::make_pair(*root, 0));
+
+    while (!dfsStack.empty()) {
+      State* state = dfsStack.back().first;
+      const std::vector<Transition*> &transitions = *state->getTransitions();
+      std::vector<Transition*>::size_type &trans = dfsStack.back().second;
+
+      // search the next unvisited interactive successor
+      while ((trans < transitions.size())
+          && (!transitions[trans]->isInteractive()
+            || (transitions[trans]->getTargetState()->getType()
+              != State::INTERACTIVE)
+            || (colours[transitions[trans]->getTargetState()->getIndex()]
+              != WHITE)))
+        ++trans;
+
+      if (trans == transitions.size()) {
+        // all successors are handled
+        colours[state->getIndex()] = BLACK;
+        order.push_back(state);
+        dfsStack.pop_back();
+        continue;
+      }
+
+      State* successor = transitions[trans++]->getTargetState();
+      colours[successor->getIndex()] = GREY;
+      // `trans` is invalid after this
+      dfsStack.push_back(std::make_pair(successor, 0));
+    }
+  }
+}
+
+// needed for Graph::computeMarkovSuccs(): computes the markov successors of
+// the States [begin, end) of `states`, `chunkSize` States per chunk
+struct _GraphClosureJob : public ThreadPool::Job {
+  static const unsigned int chunkSize = 64;
+  const std::vector<State*> &states;
+  unsigned int begin, end;
+  const std::vector<Arena<Transition>*> &arenas;
+  const LabelTable &labels;
+  Label* dfsLabel;
+  bool computeLabels;
+  // the Transitions of each chunk that still need a LabelPath
+  std::vector< std::vector<ClosureContext::PendingLabel> > pending;
+
+  _GraphClosureJob(const std::vector<State*> &s,
+      const std::vector<Arena<Transition>*> &a, const LabelTable &l,
+      Label *const &d, const bool &c)
+    : states(s), begin(0), end(0), arenas(a), labels(l), dfsLabel(d),
+      computeLabels(c) {}
+
+  unsigned int getChunkNumber() const {
+    return (end - begin + chunkSize - 1) / chunkSize;
+  }
+
+  void execute(const unsigned int &chunk, const unsigned int &worker) {
+    ClosureContext context(*arenas[worker], labels, dfsLabel, computeLabels,
+        pending[chunk]);
+    const unsigned int chunkEnd =
+      std::min(end, begin + (chunk + 1) * chunkSize);
+    for (unsigned int state = begin + chunk * chunkSize; state < chunkEnd;
+        ++state)
+      states[state]->getMarkovSuccs(context);
+  }
+};
+
+void Graph::computeMarkovSuccs(const std::vector<State*> &order,
+    const bool &computeLabels)
+{
+  // level of each State (by its index): 1 + the maximal level of its
+  // interactive successors, 0 if not computed yet
+  std::vector<unsigned int> level(states.size(), 0);
+  unsigned int noLevels = 0;
+  bool cyclic = false;
+  for (std::vector<State*>::const_iterator state = order.begin();
+      state != order.end(); ++state) {
+    unsigned int stateLevel = 1;
+    for (std::vector<Transition*>::const_iterator trans =
+        (*state)->getTransitions()->begin();
+        trans != (*state)->getTransitions()->end(); ++trans) {
+      const State* successor = (*trans)->getTargetState();
+      if (!(*trans)->isInteractive()
+          || (successor->getType() != State::INTERACTIVE)
+          || (successor == *state))
+        continue;
+      if (level[successor->getIndex()] == 0)
+        // an interactive cycle
+        cyclic = true;
+      else
+        stateLevel = std::max(stateLevel, level[successor->getIndex()] + 1);
+    }
+    level[(*state)->getIndex()] = stateLevel;
+    noLevels = std::max(noLevels, stateLevel);
+  }
+  // with interactive cycles, the successors of a State may be handled after
+  // it, so keep the order of `order` then
+  if (cyclic) {
+    noLevels = 0;
+    for (std::vector<State*>::const_iterator state = order.begin();
+        state != order.end(); ++state)
+      level[(*state)->getIndex()] = ++noLevels;
+  }
+
+  // sort the States by their level (stable)
+  std::vector<unsigned int> levelBegin(noLevels + 2, 0);
+  for (std::vector<State*>::const_iterator state = order.begin();
+      state != order.end(); ++state)
+    ++levelBegin[level[(*state)->getIndex()] + 1];
+  for (unsigned int l = 1; l < levelBegin.size(); ++l)
+    levelBegin[l] += levelBegin[l - 1];
+  std::vector<State*> byLevel(order.size());
+  {
+    std::vector<unsigned int> next(levelBegin.begin(), levelBegin.end() - 1);
+    for (std::vector<State*>::const_iterator state = order.begin();
+        state != order.end(); ++state)
+      byLevel[next[level[(*state)->getIndex()]]++] = *state;
+  }
+  level.clear();
+
+  ThreadPool pool(threads);
+  // worker 0 is the calling thread, it uses the Arena of the Graph
+  std::vector<Arena<Transition>*> arenas(1, &transitionArena);
+  while (workerArenas.size() + 1 < pool.getThreadNumber())
+    workerArenas.push_back(new Arena<Transition>());
+  arenas.insert(arenas.end(), workerArenas.begin(), workerArenas.end());
+
+  _GraphClosureJob job(byLevel, arenas, labels, computeLabels ? NULL :
+      getLabelPtr("DFS"), computeLabels);
+  for (unsigned int l = 1; l <= noLevels; ++l) {
+    job.begin = levelBegin[l];
+    job.end = levelBegin[l + 1];
+    if (job.begin == job.end)
+      continue;
+    job.pending.resize(job.getChunkNumber());
+    pool.run(job, job.getChunkNumber());
+
+    // create the missing LabelPaths, in the order of the States, so the
+    // Label ids don't depend on the number of threads
+    for (std::vector< std::vector<ClosureContext::PendingLabel> >::iterator
+        chunk = job.pending.begin(); chunk != job.pending.end(); ++chunk) {
+      for (std::vector<ClosureContext::PendingLabel>::const_iterator it =
+          chunk->begin(); it != chunk->end(); ++it)
+        it->transition->setLabel(getPathLabelPtr(it->head, it->tail));
+      chunk->clear();
+    }
+  }
+}
+
 void Graph::deleteUnreachable()
 {
   // search for reachable States
 
-  std::set<State*> reached;
-  std::vector<State*> toHandle;
-  toHandle.push_back(initialState);
-  reached.insert(initialState);
+  const GraphCSR &graph = getCSR();
+  std::vector<bool> reached(graph.getStateNumber(), false);
+  std::vector<unsigned int> toHandle;
+  toHandle.push_back(initialState->getIndex());
+  reached[initialState->getIndex()] = true;
+  unsigned int noReached(1);
   while (!toHandle.empty()) {
-    State* cur = toHandle.back();
+    const unsigned int cur = toHandle.back();
     toHandle.pop_back();
-    for (std::vector<Transition*>::const_iterator trans = cur->getTransitions()->begin();
-        trans != cur->getTransitions()->end(); ++trans)
-      // if it's not in `reached`, insert into `toHandle`
-      if (reached.insert((*trans)->getTargetState()).second) // if it was inserted...
-        toHandle.push_back((*trans)->getTargetState());
+    for (unsigned int trans = graph.getTransitionsBegin(cur);
+        trans != graph.getTransitionsEnd(cur); ++trans) {
+      const unsigned int target = graph.getTarget(trans);
+      // if it's not reached yet, insert into `toHandle`
+      if (!reached[target]) {
+        reached[target] = true;
+        ++noReached;
+        toHandle.push_back(target);
+      }
+    }
   }
 
   // if all States are reached, then we are ready
-  if (reached.size() == states.size()) {
+  if (noReached == states.size()) {
     debug("No unreachable states.");
     return;
   }
 
   // now delete all States that are not reached from initialState
   std::vector<State*> newStates;
-  newStates.reserve(reached.size());
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state)
-    if (reached.find(*state) == reached.end())
-      delete *state;
+  newStates.reserve(noReached);
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state)
+    if (!reached[state])
+      deleteState(states[state]);
     else
-      newStates.push_back(*state);
+      newStates.push_back(states[state]);
 
   warn("Deleted %d unreachable states.", (states.size() - newStates.size()));
 
   // swap `newStates` into `states`
   newStates.swap(states);
   newStates.clear();
+  invalidateCSR();
+}
+
+void Graph::minimize()
+{
+  const GraphCSR &graph = getCSR();
+
+  // States with different marks or propositions get different colours
+  std::vector<unsigned int> colours(graph.getStateNumber());
+  {
+    std::map<std::vector<bool>, unsigned int> colourIds;
+    std::vector<bool> key(propositions.size() + 1);
+    for (unsigned int state = 0; state < graph.getStateNumber(); ++state) {
+      key[0] = graph.getMark(state);
+      for (unsigned int prop = 0; prop < propositions.size(); ++prop)
+        key[prop + 1] = propositions.holds(prop, graph.getOrigin(state));
+      const unsigned int colour = colourIds.size();
+      colours[state] = colourIds.insert(std::make_pair(key, colour))
+        .first->second;
+    }
+  }
+
+  const GraphBisimulation bisimulation(graph, colours);
+  colours.clear();
+  const unsigned int noBlocks = bisimulation.getBlockNumber();
+  if (noBlocks == states.size()) {
+    debug("No bisimilar states.");
+    return;
+  }
+
+  // the first State of each class represents it
+  std::vector<State*> representatives(noBlocks, NULL);
+  std::vector<State*> newStates;
+  newStates.reserve(noBlocks);
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state) {
+    State* &representative = representatives[bisimulation.getBlock(state)];
+    if (representative == NULL) {
+      representative = states[state];
+      newStates.push_back(representative);
+    }
+  }
+  initialState =
+    representatives[bisimulation.getBlock(initialState->getIndex())];
+
+  // redirect the Transitions of the representatives
+  unsigned int noMerged(0);
+  for (std::vector<State*>::const_iterator state = newStates.begin();
+      state != newStates.end(); ++state) {
+    std::vector<Transition*> &transitions = *(*state)->getTransitions();
+    std::set< std::pair<State*, Label*> > interactive;
+    std::vector<Transition*>::size_type kept = 0;
+    for (std::vector<Transition*>::size_type trans = 0;
+        trans < transitions.size(); ++trans) {
+      Transition* transition = transitions[trans];
+      State* target = representatives[bisimulation.getBlock(
+          transition->getTargetState()->getIndex())];
+      if (transition->isInteractive()
+          && !interactive.insert(std::make_pair(target,
+              transition->getLabel())).second) {
+        deleteTransition(transition);
+        ++noMerged;
+        continue;
+      }
+      transition->setTargetState(target);
+      transitions[kept++] = transition;
+    }
+    transitions.resize(kept);
+  }
+
+  // delete the other States
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state)
+    if (representatives[bisimulation.getBlock(state)] != states[state])
+      deleteState(states[state]);
+
+  debug("Minimized the graph from %d to %d states (%.1f%%).",
+      static_cast<unsigned int>(states.size()), noBlocks,
+      100.0 * noBlocks / states.size());
+  debug("Merged %d interactive transitions.", noMerged);
+
+  // swap `newStates` into `states`
+  newStates.swap(states);
+  newStates.clear();
+  invalidateCSR();
+  // the numbers of the States are not dense anymore
+  setReadyForExport(false);
+}
+
+void Graph::reduceTau()
+{
+  // maximal progress: cut off the markov Transitions of the hybrid States
+  unsigned int noCut(0);
+  for (std::vector<State*>::const_iterator state = states.begin();
+      state != states.end(); ++state) {
+    if ((*state)->getType() != State::HYBRID)
+      continue;
+    std::vector<Transition*> &transitions = *(*state)->getTransitions();
+    std::vector<Transition*>::size_type kept = 0;
+    for (std::vector<Transition*>::size_type trans = 0;
+        trans < transitions.size(); ++trans) {
+      if (transitions[trans]->isInteractive())
+        transitions[kept++] = transitions[trans];
+      else {
+        deleteTransition(transitions[trans]);
+        ++noCut;
+      }
+    }
+    transitions.resize(kept);
+    (*state)->setType(State::INTERACTIVE);
+  }
+  debug("Cut off %d markov transitions of hybrid states.", noCut);
+  if (noCut > 0)
+    invalidateCSR();
+
+  // the target of the only (tau) Transition of each State to collapse, NULL
+  // for the States to keep
+  const GraphCSR &graph = getCSR();
+  std::vector<State*> collapseTo(states.size(), NULL);
+  for (unsigned int state = 0; state < graph.getStateNumber(); ++state) {
+    if ((states[state] == initialState)
+        || (graph.getTransitionsEnd(state)
+          - graph.getTransitionsBegin(state) != 1)
+        || !graph.isTau(graph.getTransitionsBegin(state)))
+      continue;
+    const unsigned int target =
+      graph.getTarget(graph.getTransitionsBegin(state));
+    // a State with a tau Transition into a deadlock State is an interactive
+    // State of the CTMDP, so it is kept
+    if ((target == state) || (graph.getType(target) == State::NOTDEC)
+        || (graph.getMark(target) != graph.getMark(state)))
+      continue;
+    bool samePropositions = true;
+    for (unsigned int prop = 0;
+        samePropositions && (prop < propositions.size()); ++prop)
+      samePropositions = (propositions.holds(prop, graph.getOrigin(state))
+          == propositions.holds(prop, graph.getOrigin(target)));
+    if (samePropositions)
+      collapseTo[state] = states[target];
+  }
+
+  // follow the chains to the States that are kept (an interactive cycle,
+  // which may exist without cycle search, is broken up by keeping one of
+  // its States)
+  enum status { NEW, ON_PATH, DONE };
+  std::vector<unsigned char> statuses(states.size(), NEW);
+  std::vector<State*> representatives(states.size(), NULL);
+  std::vector<unsigned int> path;
+  for (unsigned int state = 0; state < states.size(); ++state) {
+    unsigned int cur = state;
+    while ((statuses[cur] == NEW) && (collapseTo[cur] != NULL)) {
+      statuses[cur] = ON_PATH;
+      path.push_back(cur);
+      cur = collapseTo[cur]->getIndex();
+    }
+    if (statuses[cur] == ON_PATH)
+      collapseTo[cur] = NULL;
+    State* representative = (statuses[cur] == DONE)
+      ? representatives[cur] : states[cur];
+    statuses[cur] = DONE;
+    if (collapseTo[cur] == NULL)
+      representatives[cur] = states[cur];
+    for (std::vector<unsigned int>::const_iterator it = path.begin();
+        it != path.end(); ++it) {
+      statuses[*it] = DONE;
+      representatives[*it] = (collapseTo[*it] == NULL)
+        ? states[*it] : representative;
+    }
+    path.clear();
+  }
+
+  // redirect the Transitions of the States that are kept
+  std::vector<State*> newStates;
+  for (unsigned int state = 0; state < states.size(); ++state) {
+    if (collapseTo[state] != NULL)
+      continue;
+    std::vector<Transition*> &transitions = *states[state]->getTransitions();
+    for (std::vector<Transition*>::const_iterator trans =
+        transitions.begin(); trans != transitions.end(); ++trans)
+      (*trans)->setTargetState(representatives[
+          (*trans)->getTargetState()->getIndex()]);
+    newStates.push_back(states[state]);
+  }
+  debug("Collapsed %d confluent tau transitions.",
+      static_cast<unsigned int>(states.size() - newStates.size()));
+  if (newStates.size() == states.size())
+    return;
+
+  // delete the other States
+  for (unsigned int state = 0; state < states.size(); ++state)
+    if (collapseTo[state] != NULL)
+      deleteState(states[state]);
+
+  // swap `newStates` into `states`
+  newStates.swap(states);
+  newStates.clear();
+  invalidateCSR();
+  // the numbers of the States are not dense anymore
+  setReadyForExport(false);
 }
 
 void Graph::numberStates() const
 {
+  // the numbers are set in the GraphCSR and in the State objects
+  getCSR();
+  GraphCSR &graph = *csr;
+  const unsigned int initial = initialState->getIndex();
+
   // order: 1. initial State, 2. INTERACTIVE States, 3. all the Rest
-  initialState->setNumber(0);
+  graph.setNumber(initial, 0);
   unsigned int nextStateNr(0);
 
   // number INTERACTIVE states
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state)
-    if (((*state)->getType() != State::MARKOV) && (*state != initialState))
-      (*state)->setNumber(++nextStateNr);
+  for (unsigned int state = 0; state < graph.getStateNumber(); ++state)
+    if ((graph.getType(state) != State::MARKOV) && (state != initial))
+      graph.setNumber(state, ++nextStateNr);
 
   // and now the MARKOV states
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state)
-    if (((*state)->getType() == State::MARKOV) && (*state != initialState))
-      (*state)->setNumber(++nextStateNr);
+  for (unsigned int state = 0; state < graph.getStateNumber(); ++state)
+    if ((graph.getType(state) == State::MARKOV) && (state != initial))
+      graph.setNumber(state, ++nextStateNr);
 
   if (nextStateNr != states.size()-1) {
     warn("Warning: The initial state seems to be invalid");
@@ -312,83 +965,252 @@ void Graph::sortStatesByNr()
     newStates[number] = *state;
   }
   newStates.swap(states);
+  invalidateCSR();
 }
 
-Label* Graph::getLabelPtr(const std::string* label)
+Label* Graph::getLabelPtr(const std::string &label, bool quote)
 {
-  std::map<std::string, Label*>::const_iterator found =
-    labels.find(*label);
-
-  if (found != labels.end())
-    return found->second;
-  
-  Label* newLP;
   try {
-    newLP = Label::create(*label);
+    if (quote)
+      return labels.intern(Label::quote(label));
+    else
+      return labels.intern(label);
   } catch (std::runtime_error e) {
-    warn("Error creating label \"%s\": %s", label->c_str(), e.what());
+    warn("Error creating label \"%s\": %s", label.c_str(), e.what());
     exit(-1);
   }
-  labels.insert(std::make_pair(*label, newLP));
-  return newLP;
 }
 
-Label* Graph::getLabelPtr(const std::string &label, bool quote)
+Label* Graph::getPathLabelPtr(Label *const &head, Label *const &tail)
 {
-  if (quote) {
-    std::string quoted = Label::quote(label);
-    return getLabelPtr(&quoted);
-  } else {
-    return getLabelPtr(&label);
-  }
+  return labels.internPath(head, tail);
 }
 
+const LabelTable& Graph::getLabels() const
+{
+  return labels;
+}
 
-// needed for Graph::checkInteractiveCycle()
-bool _GraphCheckInteractiveCycleDFS(const State *state,
-    std::map<const State*, std::pair<bool, bool> > &type)
+PropositionTable& Graph::getPropositions()
 {
-  std::map<const State*, std::pair<bool, bool> >::iterator t = type.find(state);
-  if (t == type.end())
-    t = type.insert(std::make_pair(state, std::make_pair(false, false))).first;
+  return propositions;
+}
 
-  if (t->second.first)
-    return false; // state is ready
-  if (t->second.second)
-    return true;  // found cycle
+const PropositionTable& Graph::getPropositions() const
+{
+  return propositions;
+}
 
-  t->second.second = true;  // state is now visited
-  for (std::vector<Transition*>::const_iterator trans =
-      state->getTransitions()->begin();
-      trans != state->getTransitions()->end(); ++trans)
-    if ((*trans)->isInteractive()
-        && ((*trans)->getTargetState()->getType() != State::MARKOV)
-        && (_GraphCheckInteractiveCycleDFS((*trans)->getTargetState(), type)))
-      return true;
-  t->second.first = true; // state is ready
 
+bool Graph::checkInteractiveCycle(const bool &warnCycles,
+    std::vector<State*> *cycle) const
+{
+  const GraphCSR &graph = getCSR();
+  const unsigned int noStates = graph.getStateNumber();
+
+  // one depth-first search over the interactive Transitions of all States,
+  // without recursion. White States haven't been visited yet, grey States
+  // are on the DFS stack, and black States are finished.
+  enum colour { WHITE, GREY, BLACK };
+  std::vector<unsigned char> colours(noStates, WHITE);
+  // the DFS stack: State and its next Transition to handle
+  std::vector< std::pair<unsigned int, unsigned int> > dfsStack;
+
+  for (unsigned int root = 0; root < noStates; ++root) {
+    if ((colours[root] != WHITE)
+        || ((graph.getType(root) != State::INTERACTIVE)
+          && (graph.getType(root) != State::HYBRID)))
+      continue;
+    colours[root] = GREY;
+    dfsStack.push_back(std::make_pair(root, graph.getTransitionsBegin(root)));
+
+    while (!dfsStack.empty()) {
+      const unsigned int state = dfsStack.back().first;
+      unsigned int &trans = dfsStack.back().second;
+
+      // search the next interactive Transition
+      while ((trans != graph.getTransitionsEnd(state))
+          && !graph.isInteractive(trans))
+        ++trans;
+
+      if (trans == graph.getTransitionsEnd(state)) {
+        // all Transitions of `state` handled
+        colours[state] = BLACK;
+        dfsStack.pop_back();
+        continue;
+      }
+
+      const unsigned int target = graph.getTarget(trans++);
+      if ((colours[target] == BLACK)
+          || (graph.getType(target) == State::MARKOV))
+        continue;
+      if (colours[target] == WHITE) {
+        colours[target] = GREY;
+        // `trans` is invalid after this
+        dfsStack.push_back(std::make_pair(target,
+              graph.getTransitionsBegin(target)));
+        continue;
+      }
+
+      // `target` is grey, i.e. on the DFS stack: found a cycle
+      if (cycle != NULL) {
+        std::vector< std::pair<unsigned int, unsigned int> >::size_type
+          first = dfsStack.size() - 1;
+        while (dfsStack[first].first != target)
+          --first;
+        cycle->clear();
+        for (; first < dfsStack.size(); ++first)
+          cycle->push_back(graph.getState(dfsStack[first].first));
+      }
+      if (warnCycles) {
+        warn("WARNING: Graph has an interactive cycle!");
+        warn("The program may fail in any strange manner!!");
+      }
+      return true;
+    }
+  }
+  debug("Graph has no interactive cycle.");
   return false;
 }
 
-bool Graph::checkInteractiveCycle(const bool &warnCycles) const
+unsigned int Graph::breakInteractiveCycles()
 {
-  for (std::vector<State*>::const_iterator it = states.begin();
-      it != states.end(); ++it) {
-    if (((*it)->getType() == State::INTERACTIVE)
-      || ((*it)->getType() == State::HYBRID)) {
-      // first entry: finished, second: visited
-      std::map<const State*, std::pair<bool, bool> > type;
-      if (_GraphCheckInteractiveCycleDFS(*it, type)) {
-        if (warnCycles) {
-          warn("WARNING: Graph has an interactive cycle!");
-          warn("The program may fail in any strange manner!!");
-        }
-        return true;
+  const GraphCSR &graph = getCSR();
+  const unsigned int noStates = graph.getStateNumber();
+  const unsigned int unvisited = noStates;
+
+  // Tarjan's algorithm for the strongly connected components of the
+  // interactive Transitions, without recursion
+  std::vector<unsigned int> index(noStates, unvisited), lowlink(noStates),
+    component(noStates);
+  std::vector<bool> onStack(noStates, false), hasSelfLoop(noStates, false);
+  std::vector<unsigned int> componentSize;
+  std::vector<unsigned int> sccStack;
+  // the DFS stack: State and its next Transition to handle
+  std::vector< std::pair<unsigned int, unsigned int> > dfsStack;
+  unsigned int nextIndex(0);
+
+  for (unsigned int root = 0; root < noStates; ++root) {
+    if (index[root] != unvisited)
+      continue;
+    index[root] = lowlink[root] = nextIndex++;
+    sccStack.push_back(root);
+    onStack[root] = true;
+    dfsStack.push_back(std::make_pair(root, graph.getTransitionsBegin(root)));
+
+    while (!dfsStack.empty()) {
+      const unsigned int state = dfsStack.back().first;
+      unsigned int &trans = dfsStack.back().second;
+
+      // search the next interactive Transition
+      while ((trans != graph.getTransitionsEnd(state))
+          && !graph.isInteractive(trans))
+        ++trans;
+
+      if (trans != graph.getTransitionsEnd(state)) {
+        const unsigned int target = graph.getTarget(trans++);
+        if (target == state)
+          hasSelfLoop[state] = true;
+        else if (index[target] == unvisited) {
+          index[target] = lowlink[target] = nextIndex++;
+          sccStack.push_back(target);
+          onStack[target] = true;
+          // `trans` is invalid after this
+          dfsStack.push_back(std::make_pair(target,
+                graph.getTransitionsBegin(target)));
+        } else if (onStack[target] && (index[target] < lowlink[state]))
+          lowlink[state] = index[target];
+        continue;
+      }
+
+      // all Transitions of `state` handled
+      dfsStack.pop_back();
+      if (lowlink[state] == index[state]) {
+        // `state` is the root of a component
+        unsigned int member;
+        componentSize.push_back(0);
+        do {
+          member = sccStack.back();
+          sccStack.pop_back();
+          onStack[member] = false;
+          component[member] = componentSize.size() - 1;
+          ++componentSize.back();
+        } while (member != state);
+      }
+      if (!dfsStack.empty()) {
+        const unsigned int pred = dfsStack.back().first;
+        if (lowlink[state] < lowlink[pred])
+          lowlink[pred] = lowlink[state];
       }
     }
   }
-  debug("Graph has no interactive cycle.");
-  return false;
+
+  // number the States in non-trivial components for the CycleDetector
+  // (the `index` vector isn't needed any more)
+  std::vector<unsigned int> &localNumber = index;
+  unsigned int noCycleStates(0), noComponents(0), maxComponentSize(0);
+  for (unsigned int state = 0; state < noStates; ++state)
+    if (componentSize[component[state]] > 1)
+      localNumber[state] = noCycleStates++;
+  for (std::vector<unsigned int>::const_iterator size = componentSize.begin();
+      size != componentSize.end(); ++size)
+    if (*size > 1) {
+      ++noComponents;
+      if (*size > maxComponentSize)
+        maxComponentSize = *size;
+    }
+
+  if (noComponents > 0)
+    warn("Found %d strongly connected components with interactive cycles "
+        "(%d states in total, largest: %d states).", noComponents,
+        noCycleStates, maxComponentSize);
+
+  // now remove the self-loops, and break the cycles in the components
+  CycleDetector cycles(noCycleStates);
+  unsigned int removed(0);
+  for (unsigned int state = 0; state < noStates; ++state) {
+    const bool inCycle = (componentSize[component[state]] > 1);
+    if (!inCycle && !hasSelfLoop[state])
+      continue;
+
+    State* stateObject = graph.getState(state);
+    std::vector<Transition*> &transitions = *stateObject->getTransitions();
+    std::vector<Transition*> newTransitions;
+    newTransitions.reserve(transitions.size());
+    unsigned int trans = graph.getTransitionsBegin(state);
+    for (std::vector<Transition*>::const_iterator it = transitions.begin();
+        it != transitions.end(); ++it, ++trans) {
+      const unsigned int target = graph.getTarget(trans);
+      if (graph.isInteractive(trans)
+          && ((target == state)
+            || ((component[target] == component[state])
+              && !cycles.insertEdge(localNumber[state],
+                localNumber[target])))) {
+        #ifdef DEBUG
+        printf("Deleting Transition \"%s\" from %d to %d because of an "
+            "interactive cycle\n", (*it)->getLabel()->str().c_str(),
+            graph.getNumber(state), graph.getNumber(target));
+        #endif
+        deleteTransition(*it);
+        ++removed;
+      } else
+        newTransitions.push_back(*it);
+    }
+    if (newTransitions.size() == transitions.size())
+      continue;
+
+    // the type of the State has to be determined again
+    newTransitions.swap(transitions);
+    stateObject->setType(State::NOTDEC);
+    for (std::vector<Transition*>::const_iterator it = transitions.begin();
+        it != transitions.end(); ++it)
+      stateObject->determineStateType(*it);
+  }
+
+  if (removed > 0)
+    invalidateCSR();
+
+  return removed;
 }
 
 std::vector<State*>::size_type Graph::getStateNumber() const
@@ -475,6 +1297,26 @@ bool Graph::getCycleSearch()
   return cycleSearch;
 }
 
+void Graph::setDeferredCycleSearch(const bool &newDeferredCycleSearch)
+{
+  deferredCycleSearch = newDeferredCycleSearch;
+}
+
+bool Graph::isDeferredCycleSearch()
+{
+  return deferredCycleSearch;
+}
+
+void Graph::setThreads(const unsigned int &newThreads)
+{
+  threads = newThreads;
+}
+
+unsigned int Graph::getThreads()
+{
+  return threads;
+}
+
 const std::vector<State*>* Graph::getStates() const
 {
   return &states;
@@ -482,9 +1324,40 @@ const std::vector<State*>* Graph::getStates() const
 
 std::vector<State*>* Graph::getStates()
 {
+  invalidateCSR();
   return &states;
 }
 
+const GraphCSR& Graph::getCSR() const
+{
+  if (!csrValid) {
+    csr->build(states, labels);
+    csrValid = true;
+  }
+  return *csr;
+}
+
+void Graph::invalidateCSR()
+{
+  csrValid = false;
+  statisticsValid = false;
+}
+
+const GraphStatistics& Graph::getStatistics() const
+{
+  if (!statisticsValid) {
+    statistics->compute(getCSR());
+    statisticsValid = true;
+  }
+  return *statistics;
+}
+
+void Graph::setStatistics(GraphStatistics &newStatistics)
+{
+  statistics->swap(newStatistics);
+  statisticsValid = true;
+}
+
 void Graph::setComment(const std::string &newComment)
 {
   comment.assign(newComment);
@@ -548,6 +1421,17 @@ bool Graph::isSearchForAbsorbingStates()
   return searchForAbsorbingStates;
 }
 
+void Graph::setLabPropositions(
+    const std::vector<std::string> &newLabPropositions)
+{
+  labPropositions = newLabPropositions;
+}
+
+const std::vector<std::string>& Graph::getLabPropositions()
+{
+  return labPropositions;
+}
+
 bool Graph::checkStateInGraph(State* const& aState) const
 {
   for (std::vector<State*>::const_iterator state = states.begin();
@@ -613,41 +1497,21 @@ std::vector<std::string> Graph::formatRegistry<T>::getFormats() const
 bool Graph::checkUniformity(const bool &showWarning, double* storeMaxOutgoingRate, double* storeMinOutgoingRate) const
 {
 
-  // save the minimal and maximal outgoing rate for assure uniformity
-  double minOutgoingRate(0.0), maxOutgoingRate(0.0);
-  bool firstOutgoingRate = true;
-
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
-
-    if ((*state)->getType() != State::MARKOV)
-      continue;
-
-    double outgoingRateHere = 0.0;
-
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end();
-        ++trans)
-      outgoingRateHere += (*trans)->getRate();
-
-    if (firstOutgoingRate) {
-      firstOutgoingRate = false;
-      minOutgoingRate = outgoingRateHere;
-      maxOutgoingRate = outgoingRateHere;
-    } else {
-      if (outgoingRateHere < minOutgoingRate)
-        minOutgoingRate = outgoingRateHere;
-      if (outgoingRateHere > maxOutgoingRate)
-        maxOutgoingRate = outgoingRateHere;
-    }
-  }
+  // the minimal and maximal outgoing rate for assure uniformity, known from
+  // reading the Graph if it hasn't been modified since
+  const GraphStatistics &graph = getStatistics();
 
   if (storeMaxOutgoingRate != NULL)
-    *storeMaxOutgoingRate = maxOutgoingRate;
+    *storeMaxOutgoingRate = graph.maxExitRate;
   if (storeMinOutgoingRate != NULL)
-    *storeMinOutgoingRate = minOutgoingRate;
+    *storeMinOutgoingRate = graph.minExitRate;
 
+  return isUniform(graph.minExitRate, graph.maxExitRate, showWarning);
+}
+
+bool Graph::isUniform(const double &minOutgoingRate,
+    const double &maxOutgoingRate, const bool &showWarning)
+{
   double diff = (minOutgoingRate - maxOutgoingRate) / maxOutgoingRate;
   if (diff < 0)
     diff *= -1;
@@ -675,21 +1539,17 @@ void Graph::uniformize(const double maxOutgoingRate)
 
   unsigned int added = 0;
 
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
+  // the outgoing rates are known, and the new Transitions don't change them
+  // before the loop is done
+  const std::vector<double> &exitRates = getStatistics().exitRates;
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state) {
 
-    if ((*state)->getType() != State::MARKOV)
+    State* stateObject = states[state];
+    if (stateObject->getType() != State::MARKOV)
       continue;
 
-    double myOutgoingRate = 0.0;
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end();
-        ++trans) {
-      assert(!(*trans)->isInteractive());
-      myOutgoingRate += (*trans)->getRate();
-    }
-
+    const double myOutgoingRate = exitRates[state];
     double diff = (maxOutgoingRate - myOutgoingRate) / maxOutgoingRate;
 
     if (diff > uniformEpsilon) {
@@ -698,9 +1558,9 @@ void Graph::uniformize(const double maxOutgoingRate)
         << (maxOutgoingRate - myOutgoingRate);
       #ifdef DEBUG
       printf("Adding markov self-loop of %s to state %d.\n",
-          label.str().c_str(), (*state)->getNumber());
+          label.str().c_str(), stateObject->getNumber());
       #endif
-      (*state)->addTransition(new Transition(*state, label.str()));
+      stateObject->addTransition(newTransition(stateObject, label.str()));
       added++;
     } else if (diff < -uniformEpsilon) {
       warn("There is a State with higher outgoing rate than "
@@ -709,25 +1569,18 @@ void Graph::uniformize(const double maxOutgoingRate)
   }
 
   debug("Added %d markov self-loops.", added);
+
+  if (added > 0)
+    invalidateCSR();
 }
 
 bool Graph::hasInternalNondeterminism() const
 {
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
-    if ((*state)->getType() == State::MARKOV)
-      continue;
-
-    std::set<Label*> seenLabels;
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end();
-        ++trans)
-      if (!seenLabels.insert((*trans)->getLabel()).second)
-        return true;
-  }
-
-  return false;
+  // known from the statistics, unless they have been collected while
+  // reading the Graph
+  if (!getStatistics().nondeterminismKnown)
+    statistics->compute(getCSR());
+  return statistics->internalNondeterminism;
 }
 
 void Graph::setColorDebug(char* newDebugColorString)
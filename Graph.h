@@ -6,13 +6,17 @@
 #include <string>
 #include <stdexcept>
 #include <stdio.h>
+#include "Arena.h"
+#include "LabelTable.h"
+#include "PropositionTable.h"
 
 // Forward-Declarations
 class State;
 class Transition;
-class Label;
 class GraphInput;
 class GraphOutput;
+class GraphCSR;
+struct GraphStatistics;
 
 /// Encapsulates a whole Graph with all States and Transitions.
 class Graph {
@@ -78,15 +82,117 @@ class Graph {
      * @param computeLabels Compute the labels to markov successors of interactive
      *                      States?
      *                      If false, all labels will be "DFS".
+     *
+     * The markov successors of the interactive States are computed by
+     * getThreads() threads.
      */
     void transformImcToCtmdp(const bool &computeLabels = true);
 
+    /** \brief Transform the reachable part of the IMC to a CTMDP
+     *
+     * Does the same as deleteUnreachable(), uniformize(),
+     * transformImcToCtmdp(), deleteUnreachable() and prepareForExport() one
+     * after the other, but in one breadth-first search from the initial
+     * State: the markov successors are only computed for the interactive
+     * States that are reached, the States that are not reached are only
+     * deleted, and the States are numbered in the order they are found (the
+     * interactive ones before the markov ones, see numberStates()).
+     *
+     * The uniform rate is the maximal exit rate of the reached markov States
+     * of the CTMDP. The markov successors are computed by one thread.
+     *
+     * @param computeLabels see transformImcToCtmdp()
+     * @param uniformize    Uniformize the CTMDP? (A warning is printed, if
+     *                      it is not uniform, see checkUniformity())
+     */
+    void transformReachable(const bool &computeLabels = true,
+        const bool &uniformize = true);
+
+    /** \brief Create a new State, using the memory of the Graph.
+     *
+     * All States and Transitions of a Graph are allocated in slabs (see
+     * Arena) that are owned by the Graph and freed all at once, when the
+     * Graph is destroyed. Hence, they must be created by newState() and
+     * newTransition() and must not be deleted by `delete`, but by
+     * deleteState() or deleteTransition().
+     *
+     * The new State is not inserted into the vector of States.
+     */
+    State* newState();
+
+    /// Create a new Transition, using the memory of the Graph (see newState())
+    Transition* newTransition(State *const &target, Label *const &label);
+
+    /// Create a new Transition, using the memory of the Graph (see newState())
+    Transition* newTransition(State *const &target, const std::string &label);
+
+    /// Create a copy of a Transition, using the memory of the Graph
+    Transition* newTransition(const Transition &transition);
+
+    /** \brief Delete a State together with its Transitions
+     *
+     * The memory is reused for new States and Transitions. The State must
+     * have been created by newState(), and it is not removed from the vector
+     * of States.
+     */
+    void deleteState(State *const &state);
+
+    /** \brief Delete a Transition
+     *
+     * The memory is reused for new Transitions. The Transition must have
+     * been created by newTransition(), and it is not removed from the
+     * Transitions of its State.
+     */
+    void deleteTransition(Transition *const &transition);
+
+    /** \brief Make room for the given number of new Transitions
+     *
+     * The next `number` Transitions created by newTransition() are
+     * allocated in one contiguous block (see Arena::reserve()).
+     */
+    void reserveTransitions(const unsigned int &number);
+
     /** \brief Delete unreachable States
      *
      * All States, that are not reachable from the initial State, are deleted.
      */
     void deleteUnreachable();
 
+    /** \brief Merge the strongly bisimilar States
+     *
+     * The bisimilar States are computed by GraphBisimulation, States with
+     * different marks or atomic propositions are never merged. The first
+     * State of each class of bisimilar States is kept, the Transitions to
+     * the other ones are redirected to it. Interactive Transitions that
+     * become equal by this are only kept once.
+     *
+     * Before the transformation, this minimizes the IMC. After it, this
+     * lumps the CTMDP: interactive States with the same actions to
+     * equivalent markov States, and markov States with the same sums of
+     * rates into each class of equivalent interactive States, are merged.
+     * The sums of rates are equal within a relative tolerance (see
+     * GraphBisimulation), the kept State keeps its own rates.
+     */
+    void minimize();
+
+    /** \brief Reduce the interactive part of the IMC before the transformation
+     *
+     * Applies maximal progress: the markov Transitions of the hybrid States
+     * can never be taken, so they are deleted here (and the States become
+     * interactive) instead of in State::getMarkovSuccs().
+     *
+     * Then the confluent tau Transitions are collapsed: if the only
+     * Transition of a State is a tau Transition, the State has no choice
+     * but to take it, and it has the same markov successors with the same
+     * labels as the target of the Transition. So all Transitions to the
+     * State are redirected to the target and the State is deleted, unless
+     * it is the initial State, the target is a deadlock State, or its mark
+     * or atomic propositions differ from the ones of the target. Chains of
+     * such States are collapsed at once, so their markov successors are not
+     * copied along the chain.
+     */
+    void reduceTau();
+
     /** \brief Serially number all States
      *
      * Each States gets a unique Number between 0 and (states.size() - 1).
@@ -101,7 +207,7 @@ class Graph {
     /** \brief Store the label in the Graph object and return a pointer to it
      *
      * Because many labels are equal, it saves a lot of memory to store the
-     * labels globally in the Graph object.
+     * labels once per Graph (see LabelTable).
      * The Transitions should only contain pointers to the Labels
      * returned by this method.
      *
@@ -110,15 +216,69 @@ class Graph {
      * @param quote If true, the given label is quoted (see Label::quote) before
      * 							it is processed
      */
-    static Label* getLabelPtr(const std::string &label, bool quote = false);
+    Label* getLabelPtr(const std::string &label, bool quote = false);
+
+    /** \brief Return the LabelPath for the given head and tail.
+     *
+     * The LabelPaths are stored in the Graph object like the other Labels
+     * (see getLabelPtr() and LabelPath), so equal paths are represented by
+     * the same Label.
+     *
+     * @param head The Label of the first Transition of the path
+     * @param tail The Label of the rest of the path
+     */
+    Label* getPathLabelPtr(Label *const &head, Label *const &tail);
+
+    /** \brief Get all Labels of the Graph.
+     *
+     * The ids of the Labels (see Label::getId()) are the indices in the
+     * LabelTable.
+     */
+    const LabelTable& getLabels() const;
+
+    /** \brief Get the atomic propositions of the Graph.
+     *
+     * They refer to the States by their origins (see State::getOrigin()).
+     * Used by the GraphInput objects, that read them.
+     */
+    PropositionTable& getPropositions();
+
+    /// Get the (constant) atomic propositions of the Graph
+    const PropositionTable& getPropositions() const;
 
     /** \brief Checks for an interactive cycle in the Graph.
+     *
+     * One iterative depth-first search over the interactive Transitions of
+     * all States is done, so this takes linear time in the size of the
+     * Graph.
      *
      * @param warnCycles If true, a warning is printed if a cycle is found.
+     * @param cycle      If not NULL and a cycle is found, the States of the
+     *                   cycle are stored here: each State has an interactive
+     *                   Transition to the next one, and the last State has
+     *                   one to the first State.
      * @return true, if the Graph contains an interactive cycle, false
      *         otherwise.
      */
-    bool checkInteractiveCycle(const bool &warnCycles = true) const;
+    bool checkInteractiveCycle(const bool &warnCycles = true,
+        std::vector<State*> *cycle = NULL) const;
+
+    /** \brief Remove Transitions until there is no interactive cycle.
+     *
+     * The strongly connected components of the interactive part of the Graph
+     * are computed in one pass (Tarjan's algorithm). Interactive self-loops
+     * are removed. The interactive Transitions inside of each non-trivial
+     * component are inserted into a CycleDetector in the order of their
+     * source States, and each Transition that would close a cycle is
+     * removed. For input files whose Transitions are sorted by their source
+     * State, this removes exactly the Transitions that are removed if the
+     * cycles are searched while reading (see setDeferredCycleSearch()).
+     *
+     * The types of the States are updated.
+     *
+     * @return The number of removed Transitions
+     */
+    unsigned int breakInteractiveCycles();
 
     /** \brief State-to-State reachability check.
      *
@@ -190,6 +350,34 @@ class Graph {
      */
     static bool getCycleSearch();
 
+    /** \brief Set the static attribute deferredCycleSearch.
+     *
+     * If set (and cycleSearch is set), the GraphInput-Classes read all
+     * Transitions without checking for interactive cycles, and call
+     * breakInteractiveCycles() after reading the file instead.
+     */
+    static void setDeferredCycleSearch(const bool &newDeferredCycleSearch);
+
+    /** \brief Get the static attribute deferredCycleSearch.
+     *
+     * See setDeferredCycleSearch().
+     */
+    static bool isDeferredCycleSearch();
+
+    /** \brief Set the static attribute threads.
+     *
+     * The number of threads that compute the markov successors of the
+     * interactive States in transformImcToCtmdp(), and that parse the
+     * transitions in GraphInputPrism. The result does not depend on it.
+     */
+    static void setThreads(const unsigned int &newThreads);
+
+    /** \brief Get the static attribute threads.
+     *
+     * See setThreads().
+     */
+    static unsigned int getThreads();
+
     /** \brief Set the static attribute searchForAbsorbingStates.
      *
      * See GraphOutputLab.
@@ -203,6 +391,21 @@ class Graph {
      */
     static bool isSearchForAbsorbingStates();
 
+    /** \brief Set the static attribute labPropositions.
+     *
+     * The names of the atomic propositions (see getPropositions()) that are
+     * written to the .lab files, in addition to "reach" and "absorbing" (see
+     * GraphOutputLab). The name "all" stands for all propositions.
+     */
+    static void setLabPropositions(
+        const std::vector<std::string> &newLabPropositions);
+
+    /** \brief Get the static attribute labPropositions.
+     *
+     * See setLabPropositions().
+     */
+    static const std::vector<std::string>& getLabPropositions();
+
     /** \brief Set the static attribute readyForExport.
      *
      * If set to true, the method prepareForExport() immediately returns
@@ -241,9 +444,48 @@ class Graph {
      *
      * Used mainly by the GraphInput objects, that need direct (write) access
      * to the vector of all states.
+     * Discards the cached GraphCSR (see invalidateCSR()).
      */
     std::vector<State*>* getStates();
 
+    /** \brief Get the compressed sparse row read cache of the Graph.
+     *
+     * The GraphCSR is built from the States and Transitions on the first
+     * call and then cached, until the Graph is modified by one of its
+     * methods or the non-constant getStates() is called. It is a copy, the
+     * States and Transitions remain the storage of the Graph.
+     * Passes that only read the Graph (e.g. the GraphOutput objects) should
+     * use the GraphCSR, because it stores the States and Transitions in
+     * contiguous arrays.
+     *
+     * The returned reference is valid until the Graph is modified.
+     */
+    const GraphCSR& getCSR() const;
+
+    /** \brief Discard the cached GraphCSR and GraphStatistics.
+     *
+     * Has to be called after the States or Transitions have been modified
+     * directly, i.e. not by a method of the Graph.
+     */
+    void invalidateCSR();
+
+    /** \brief Get the statistics of the Graph.
+     *
+     * Like the GraphCSR, they are cached until the Graph is modified. If they
+     * are not known from reading the Graph (see setStatistics()), they are
+     * computed by one pass over the GraphCSR.
+     *
+     * The returned reference is valid until the Graph is modified.
+     */
+    const GraphStatistics& getStatistics() const;
+
+    /** \brief Set the statistics of the Graph, e.g. collected while reading
+     *
+     * They have to describe the current States and Transitions. The given
+     * object is exchanged with the former statistics.
+     */
+    void setStatistics(GraphStatistics &newStatistics);
+
     /// Check if a specific State is contained in the Graph.
     bool checkStateInGraph(State* const& aState) const;
 
@@ -418,15 +660,56 @@ class Graph {
           std::map<std::string, T1*> registry;
       };
 
-    static Label* getLabelPtr(const std::string *label);
+    // writes the statistics of the IMC and of the CTMDP of a transformation
+    void debugTransformation(const GraphStatistics &imc,
+        const GraphStatistics &ctmdp) const;
+
+    // are the minimal and maximal sum of outgoing rates equal? (see
+    // checkUniformity())
+    static bool isUniform(const double &minOutgoingRate,
+        const double &maxOutgoingRate, const bool &showWarning);
+
+    // stores the interactive States in the order in which their markov
+    // successors are computed (see State::getMarkovSuccs): the post-order of
+    // an iterative DFS along the interactive Transitions, i.e. (without
+    // interactive cycles) each State comes after its interactive successors
+    // the indices of the States must be valid (see State::getIndex())
+    void getClosureOrder(std::vector<State*> &order) const;
+
+    // computes the markov successors of the States in `order` (see
+    // getClosureOrder()): the States are grouped into levels, such that the
+    // interactive successors of a State are in lower levels, and the States
+    // of one level are handled concurrently
+    void computeMarkovSuccs(const std::vector<State*> &order,
+        const bool &computeLabels);
 
     // vector of all States
     std::vector<State*> states;
 
-    // map of Labels
+    // the memory of all States and Transitions of the Graph
+    Arena<State> stateArena;
+    Arena<Transition> transitionArena;
+    // the memory of the Transitions created by the other threads in
+    // computeMarkovSuccs(); the Arenas release each other's Transitions
+    // (see Arena::release()), so they are only freed together with
+    // transitionArena, when the Graph is destroyed
+    std::vector<Arena<Transition>*> workerArenas;
+
+    // the CSR representation of `states`, valid if csrValid is set
+    GraphCSR* csr;
+    mutable bool csrValid;
+
+    // the statistics of `states`, valid if statisticsValid is set
+    GraphStatistics* statistics;
+    mutable bool statisticsValid;
+
+    // all Labels of the Graph
     // the Transitions only know pointers to this Labels, because many
     // labels are equal
-    static std::map<std::string, Label*> labels;
+    LabelTable labels;
+
+    // the atomic propositions of the States
+    PropositionTable propositions;
 
     // pointer to initial state
     State* initialState;
@@ -439,12 +722,17 @@ class Graph {
 
     // options for reading the input files
     static bool cycleSearch;
+    static bool deferredCycleSearch;
+
+    // number of threads for transformImcToCtmdp()
+    static unsigned int threads;
 
     // if this is set, the graph shouldn't change any more
     bool readyForExport;
 
     // option for writing the output file
     static bool searchForAbsorbingStates;
+    static std::vector<std::string> labPropositions;
 
     // different colors for debug/warning output
     static char* colorDebug;
@@ -0,0 +1,312 @@
+#include "GraphBisimulation.h"
+#include <algorithm>
+#include <utility>
+#include "GraphCSR.h"
+
+const unsigned int GraphBisimulation::none = ~0u;
+const double GraphBisimulation::rateEpsilon = 1e-8;
+
+// needed for GraphBisimulation::splitByRates(): orders States by their
+// classes and by their sums of rates
+struct _GraphBisimulationByRate {
+  const std::vector<unsigned int> &blocks;
+  const std::vector<double> &rates;
+
+  _GraphBisimulationByRate(const std::vector<unsigned int> &b,
+      const std::vector<double> &r) : blocks(b), rates(r) {}
+
+  bool operator()(const unsigned int &s1, const unsigned int &s2) const {
+    if (blocks[s1] != blocks[s2])
+      return blocks[s1] < blocks[s2];
+    if (rates[s1] != rates[s2])
+      return rates[s1] < rates[s2];
+    return s1 < s2;
+  }
+};
+
+GraphBisimulation::GraphBisimulation(const GraphCSR &graph,
+    const std::vector<unsigned int> &colours)
+  : graph(graph)
+{
+  const unsigned int noStates = graph.getStateNumber();
+  const unsigned int noTransitions = graph.getTransitionNumber();
+
+  // the source of each Transition, and the Transitions into each State
+  sources.resize(noTransitions);
+  predecessorsBegin.assign(noStates + 1, 0);
+  for (unsigned int state = 0; state < noStates; ++state)
+    for (unsigned int trans = graph.getTransitionsBegin(state);
+        trans != graph.getTransitionsEnd(state); ++trans) {
+      sources[trans] = state;
+      ++predecessorsBegin[graph.getTarget(trans) + 1];
+    }
+  for (unsigned int state = 0; state < noStates; ++state)
+    predecessorsBegin[state + 1] += predecessorsBegin[state];
+  predecessors.resize(noTransitions);
+  {
+    std::vector<unsigned int> next(predecessorsBegin.begin(),
+        predecessorsBegin.end() - 1);
+    for (unsigned int trans = 0; trans < noTransitions; ++trans)
+      predecessors[next[graph.getTarget(trans)]++] = trans;
+  }
+
+  // the initial classes are the colours, they form the first splitter
+  std::vector< std::pair<unsigned int, unsigned int> > byColour(noStates);
+  for (unsigned int state = 0; state < noStates; ++state)
+    byColour[state] = std::make_pair(colours[state], state);
+  std::sort(byColour.begin(), byColour.end());
+
+  elements.resize(noStates);
+  location.resize(noStates);
+  stateBlock.resize(noStates);
+  splitterFirst.push_back(none);
+  isPending.push_back(false);
+  for (unsigned int pos = 0; pos < noStates; ++pos) {
+    if ((pos == 0) || (byColour[pos].first != byColour[pos - 1].first)) {
+      const unsigned int block = blockBegin.size();
+      if (block == 0)
+        splitterFirst[0] = block;
+      else
+        blockNext[block - 1] = block;
+      blockBegin.push_back(pos);
+      blockEnd.push_back(pos);
+      blockMarked.push_back(0);
+      blockSplitter.push_back(0);
+      blockNext.push_back(none);
+    }
+    const unsigned int state = byColour[pos].second;
+    elements[pos] = state;
+    location[state] = pos;
+    stateBlock[state] = blockBegin.size() - 1;
+    ++blockEnd.back();
+  }
+  byColour.clear();
+  if (blockBegin.size() > 1) {
+    pending.push_back(0);
+    isPending[0] = true;
+  }
+
+  // the counters of the interactive Transitions into all States (one per
+  // State and Label), and the exit rates
+  transitionCounter.assign(noTransitions, none);
+  rates.assign(noStates, 0.0);
+  std::vector<unsigned int> labelCounter(graph.getLabelNumber(), none);
+  std::vector<Incoming> incoming;
+  std::vector<unsigned int> markovSources;
+  for (unsigned int state = 0; state < noStates; ++state) {
+    const unsigned int firstCounter = counters.size();
+    for (unsigned int trans = graph.getTransitionsBegin(state);
+        trans != graph.getTransitionsEnd(state); ++trans) {
+      if (graph.isInteractive(trans)) {
+        const unsigned int label = graph.getLabelId(trans);
+        unsigned int &counter = labelCounter[label];
+        if ((counter == none) || (counter < firstCounter)) {
+          counter = counters.size();
+          counters.push_back(0);
+          const Incoming in = { label, state, none };
+          incoming.push_back(in);
+        }
+        ++counters[counter];
+        transitionCounter[trans] = counter;
+      } else if (graph.getRate(trans) > 0.0) {
+        if (rates[state] == 0.0)
+          markovSources.push_back(state);
+        rates[state] += graph.getRate(trans);
+      }
+    }
+  }
+  labelCounter.clear();
+
+  // now each class is stable with respect to the first splitter
+  splitByLabels(incoming, false);
+  splitByRates(markovSources);
+
+  while (!pending.empty()) {
+    const unsigned int splitter = pending.back();
+    const unsigned int first = splitterFirst[splitter];
+    const unsigned int second = blockNext[first];
+    if (second == none) {
+      isPending[splitter] = false;
+      pending.pop_back();
+      continue;
+    }
+
+    // the smaller one of the first two classes of the splitter contains at
+    // most half of its States, it becomes a splitter of its own
+    unsigned int block = first;
+    if (blockEnd[second] - blockBegin[second]
+        < blockEnd[first] - blockBegin[first])
+      block = second;
+    if (block == first)
+      splitterFirst[splitter] = second;
+    else
+      blockNext[first] = blockNext[second];
+    blockSplitter[block] = splitterFirst.size();
+    blockNext[block] = none;
+    splitterFirst.push_back(block);
+    isPending.push_back(false);
+
+    split(block);
+  }
+}
+
+GraphBisimulation::~GraphBisimulation()
+{
+  // nothing to do
+}
+
+void GraphBisimulation::split(const unsigned int &splitter)
+{
+  // the States of the class (it may be split itself)
+  const std::vector<unsigned int> states(elements.begin()
+      + blockBegin[splitter], elements.begin() + blockEnd[splitter]);
+
+  // move the interactive Transitions into the class to new counters
+  std::vector<Incoming> incoming;
+  std::vector<unsigned int> oldCounters, markovSources;
+  newCounter.resize(counters.size(), none);
+  for (std::vector<unsigned int>::const_iterator state = states.begin();
+      state != states.end(); ++state) {
+    for (unsigned int pred = predecessorsBegin[*state];
+        pred != predecessorsBegin[*state + 1]; ++pred) {
+      const unsigned int trans = predecessors[pred];
+      const unsigned int source = sources[trans];
+      if (graph.isInteractive(trans)) {
+        const unsigned int old = transitionCounter[trans];
+        unsigned int &counter = newCounter[old];
+        if (counter == none) {
+          counter = counters.size();
+          counters.push_back(0);
+          oldCounters.push_back(old);
+          const Incoming in = { graph.getLabelId(trans), source, old };
+          incoming.push_back(in);
+        }
+        ++counters[counter];
+        --counters[old];
+        transitionCounter[trans] = counter;
+      } else if (graph.getRate(trans) > 0.0) {
+        if (rates[source] == 0.0)
+          markovSources.push_back(source);
+        rates[source] += graph.getRate(trans);
+      }
+    }
+  }
+  for (std::vector<unsigned int>::const_iterator old = oldCounters.begin();
+      old != oldCounters.end(); ++old)
+    newCounter[*old] = none;
+
+  splitByLabels(incoming, true);
+  splitByRates(markovSources);
+}
+
+void GraphBisimulation::splitByLabels(std::vector<Incoming> &incoming,
+    const bool &withRest)
+{
+  std::sort(incoming.begin(), incoming.end());
+  std::vector<Incoming>::size_type begin = 0, end;
+  for (; begin < incoming.size(); begin = end) {
+    const unsigned int label = incoming[begin].label;
+    for (end = begin; (end < incoming.size())
+        && (incoming[end].label == label); ++end)
+      mark(incoming[end].source);
+    splitMarked();
+
+    if (!withRest)
+      continue;
+
+    // each class was stable with respect to the old splitter, so only the
+    // States without a Transition into the rest of it have to be split
+    for (std::vector<Incoming>::size_type i = begin; i < end; ++i)
+      if (counters[incoming[i].rest] == 0)
+        mark(incoming[i].source);
+    splitMarked();
+  }
+}
+
+void GraphBisimulation::splitByRates(std::vector<unsigned int> &states)
+{
+  // the States of each class with equal sums of rates are split from it
+  // (the States without markov Transitions into the splitter have the sum
+  // 0.0, they stay in the class); the sums are sorted, and each group
+  // holds the sums that exceed its lowest one by at most rateEpsilon
+  // (relative)
+  std::sort(states.begin(), states.end(),
+      _GraphBisimulationByRate(stateBlock, rates));
+  std::vector<unsigned int>::size_type begin = 0, end;
+  for (; begin < states.size(); begin = end) {
+    const double lowest = rates[states[begin]];
+    for (end = begin; (end < states.size())
+        && (stateBlock[states[end]] == stateBlock[states[begin]])
+        && (rates[states[end]] - lowest <= rateEpsilon * rates[states[end]]);
+        ++end)
+      mark(states[end]);
+    splitMarked();
+  }
+
+  for (std::vector<unsigned int>::const_iterator state = states.begin();
+      state != states.end(); ++state)
+    rates[*state] = 0.0;
+}
+
+void GraphBisimulation::mark(const unsigned int &state)
+{
+  const unsigned int block = stateBlock[state];
+  const unsigned int position = location[state];
+  const unsigned int firstUnmarked = blockBegin[block] + blockMarked[block];
+  if (position < firstUnmarked)
+    return;
+
+  if (blockMarked[block] == 0)
+    touchedBlocks.push_back(block);
+  ++blockMarked[block];
+
+  // swap the State to the marked ones
+  const unsigned int other = elements[firstUnmarked];
+  elements[firstUnmarked] = state;
+  location[state] = firstUnmarked;
+  elements[position] = other;
+  location[other] = position;
+}
+
+void GraphBisimulation::splitMarked()
+{
+  for (std::vector<unsigned int>::const_iterator it = touchedBlocks.begin();
+      it != touchedBlocks.end(); ++it) {
+    const unsigned int block = *it;
+    const unsigned int marked = blockMarked[block];
+    const unsigned int size = blockEnd[block] - blockBegin[block];
+    blockMarked[block] = 0;
+    if (marked == size)
+      continue;
+
+    // the smaller part becomes the new class
+    const unsigned int newBlock = blockBegin.size();
+    unsigned int newBegin, newEnd;
+    if (2 * marked <= size) {
+      newBegin = blockBegin[block];
+      newEnd = newBegin + marked;
+      blockBegin[block] = newEnd;
+    } else {
+      newBegin = blockBegin[block] + marked;
+      newEnd = blockEnd[block];
+      blockEnd[block] = newBegin;
+    }
+    blockBegin.push_back(newBegin);
+    blockEnd.push_back(newEnd);
+    blockMarked.push_back(0);
+    for (unsigned int pos = newBegin; pos < newEnd; ++pos)
+      stateBlock[elements[pos]] = newBlock;
+
+    // the new class belongs to the same splitter, which has to be used again
+    const unsigned int splitter = blockSplitter[block];
+    const unsigned int next = blockNext[block];
+    blockSplitter.push_back(splitter);
+    blockNext.push_back(next);
+    blockNext[block] = newBlock;
+    if (!isPending[splitter]) {
+      isPending[splitter] = true;
+      pending.push_back(splitter);
+    }
+  }
+  touchedBlocks.clear();
+}
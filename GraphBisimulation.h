@@ -0,0 +1,133 @@
+#ifndef __GRAPHBISIMULATION_H
+#define __GRAPHBISIMULATION_H
+
+#include <vector>
+
+// forward-declarations
+class GraphCSR;
+
+/** \brief The coarsest strong bisimulation of an IMC.
+ *
+ * Two States are strongly bisimilar, if they have the same colour (e.g. the
+ * same mark), if for each Label one of them has an interactive Transition
+ * with that Label into a class of bisimilar States iff the other one has
+ * one, and if the sums of the rates of their markov Transitions into each
+ * class are equal. The sums are compared with the relative tolerance
+ * rateEpsilon, so that rates summed up in a different order (e.g. 0.1 + 0.2
+ * and 0.3) are equal. The classes are computed by partition refinement: each
+ * class that is split up is used as a splitter later, and the splitting by
+ * the largest part of it is implied by the splitting by the other parts.
+ * For the interactive Transitions, this needs the number of Transitions of
+ * each State and Label into the class before it was split (the algorithm of
+ * Paige and Tarjan, "Three Partition Refinement Algorithms", 1987), for the
+ * markov Transitions, the sums of the rates suffice (see Valmari and
+ * Franceschinis, "Simple O(m log n) Time Markov Chain Lumping", 2010). So
+ * each Transition is handled O(log n) times.
+ *
+ * Graph::minimize() merges the bisimilar States.
+ */
+class GraphBisimulation {
+  public:
+    /** \brief Constructor, computes the bisimilar States
+     *
+     * @param graph   The Graph (the interactive Transitions are compared by
+     *                their Labels, the markov Transitions by their rates)
+     * @param colours A colour for each State (indexed by the State index),
+     *                States with different colours are never bisimilar
+     */
+    GraphBisimulation(const GraphCSR &graph,
+        const std::vector<unsigned int> &colours);
+
+    /// Destructor
+    ~GraphBisimulation();
+
+    /// Returns the number of classes of bisimilar States
+    unsigned int getBlockNumber() const {
+      return blockBegin.size();
+    }
+
+    /// Returns the class of the State with the given index
+    unsigned int getBlock(const unsigned int &state) const {
+      return stateBlock[state];
+    }
+
+  private:
+
+    // an interactive Transition into the splitter
+    struct Incoming {
+      unsigned int label;
+      unsigned int source;
+      // the counter of the Transitions of the source with the label into the
+      // rest of the old class of the splitter
+      unsigned int rest;
+
+      bool operator<(const Incoming &other) const {
+        return (label != other.label) ? (label < other.label)
+          : (source < other.source);
+      }
+    };
+
+    // split all classes by the given class of the splitters
+    void split(const unsigned int &splitter);
+
+    // split the classes by the interactive Transitions, if `withRest`, also
+    // by the Transitions into the rest of the old class of the splitter
+    void splitByLabels(std::vector<Incoming> &incoming, const bool &withRest);
+
+    // split the classes of the given States by their sums of rates
+    void splitByRates(std::vector<unsigned int> &states);
+
+    // mark a State to be split from its class
+    void mark(const unsigned int &state);
+
+    // split the marked States from the classes they are in
+    void splitMarked();
+
+    static const unsigned int none;
+
+    // the relative tolerance for equal sums of rates (see
+    // Graph::uniformEpsilon)
+    static const double rateEpsilon;
+
+    const GraphCSR &graph;
+
+    // the source of each Transition, and the Transitions into each State
+    // (predecessors[predecessorsBegin[s]] to predecessors[predecessorsBegin[s
+    // + 1]] for State s)
+    std::vector<unsigned int> sources;
+    std::vector<unsigned int> predecessorsBegin, predecessors;
+
+    // the States, grouped by their classes, and the position of each State
+    std::vector<unsigned int> elements, location;
+
+    // the class of each State
+    std::vector<unsigned int> stateBlock;
+
+    // for each class, its States are elements[blockBegin] to
+    // elements[blockEnd], the first blockMarked ones of them are marked
+    std::vector<unsigned int> blockBegin, blockEnd, blockMarked;
+
+    // the classes with marked States
+    std::vector<unsigned int> touchedBlocks;
+
+    // the splitters are the unions of classes, blockNext links the classes
+    // of a splitter, starting with splitterFirst
+    std::vector<unsigned int> blockSplitter, blockNext, splitterFirst;
+
+    // the splitters of more than one class, which still have to be used
+    std::vector<unsigned int> pending;
+    std::vector<bool> isPending;
+
+    // for each interactive Transition, its counter: the number of
+    // Transitions of its source with its Label into its splitter
+    std::vector<unsigned int> transitionCounter, counters;
+
+    // the new counter for each old counter while splitting
+    std::vector<unsigned int> newCounter;
+
+    // the sum of the rates of each State into the splitter
+    std::vector<double> rates;
+
+};
+
+#endif
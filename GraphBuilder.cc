@@ -0,0 +1,122 @@
+#include "GraphBuilder.h"
+#ifdef DEBUG
+  #include <stdio.h>
+#endif
+#include "Graph.h"
+#include "State.h"
+#include "Transition.h"
+#include "Label.h"
+
+GraphBuilder::GraphBuilder(Graph &graph, const unsigned int &noStates)
+  : graph(graph), states(*graph.getStates()), counts(noStates, 0),
+    onlineCycleSearch(graph.getCycleSearch()
+        && !graph.isDeferredCycleSearch()),
+    interactiveTransitions(onlineCycleSearch ? noStates : 0), removed(0)
+{
+  statistics.exitRates.resize(noStates, 0.0);
+
+  states.resize(noStates);
+  unsigned int nr = 0;
+  for (std::vector<State*>::iterator it = states.begin();
+      it != states.end(); ++it) {
+    *it = graph.newState();
+    (*it)->setOrigin(nr);
+    (*it)->setNumber(++nr);
+  }
+}
+
+GraphBuilder::~GraphBuilder()
+{
+  // nothing to do, the States and Transitions belong to the Graph
+}
+
+void GraphBuilder::reserve()
+{
+  // the Transitions that have actually been counted, the reader checks
+  // them against the file header afterwards
+  unsigned int noTransitions = 0;
+  for (std::vector<State*>::size_type state = 0; state < states.size();
+      ++state) {
+    states[state]->reserveTransitions(counts[state]);
+    noTransitions += counts[state];
+  }
+  graph.reserveTransitions(noTransitions);
+  std::vector<unsigned int>().swap(counts);
+}
+
+void GraphBuilder::markState(const unsigned int &state)
+{
+  states[state]->setMark(true);
+}
+
+bool GraphBuilder::addTransition(const unsigned int &source,
+    const unsigned int &target, Label *const &label)
+{
+  State *const &sourceState = states[source],
+        *const &targetState = states[target];
+  const bool interactive = label->isInteractive();
+
+  // prove that the new Transition doesn't cause an interactive cycle
+  if (interactive
+      && onlineCycleSearch
+      && !interactiveTransitions.insertEdge(source, target)) {
+    #ifdef DEBUG
+    std::vector<Transition*> cycle = graph.getPath(targetState,
+        sourceState, true);
+    printf("Deleting Transition \"%s\" from %d to %d because of this "
+        "cycle:\n   %d", label->str().c_str(), sourceState->getNumber(),
+        targetState->getNumber(), targetState->getNumber());
+    for (std::vector<Transition*>::iterator it = cycle.begin();
+        it != cycle.end(); ++it)
+      printf(" --%s--> %d", (*it)->getLabel()->str().c_str(),
+          (*it)->getTargetState()->getNumber());
+    printf(" --%s--> %d\n", label->str().c_str(), targetState->getNumber());
+    #endif
+    ++removed;
+    return false;
+  }
+
+  Transition* newTransition = graph.newTransition(targetState, label);
+
+  // determine state type
+  sourceState->determineStateType(newTransition);
+
+  // add transition to state
+  sourceState->addTransition(newTransition);
+
+  if (interactive)
+    ++statistics.noInteractiveTransitions;
+  else {
+    ++statistics.noMarkovTransitions;
+    statistics.exitRates[source] += label->getRate();
+  }
+
+  return true;
+}
+
+unsigned int GraphBuilder::finish()
+{
+  std::vector<unsigned int>().swap(counts);
+
+  // break the interactive cycles now, if the search has been deferred
+  unsigned int removedLater = 0;
+  if (graph.getCycleSearch() && graph.isDeferredCycleSearch())
+    removedLater = graph.breakInteractiveCycles();
+  removed += removedLater;
+
+  // the types of the States are known now (the removed Transitions would
+  // have to be subtracted again, so leave the statistics to the Graph then)
+  if (removedLater == 0) {
+    for (std::vector<State*>::size_type state = 0; state < states.size();
+        ++state)
+      statistics.addState(state, states[state]->getType(),
+          states[state]->getTransitions()->size());
+    graph.setStatistics(statistics);
+  }
+
+  if (removed > 0)
+    graph.warn("%d transitions removed because they would have caused "
+        "interactive cycles", removed);
+
+  return removed;
+}
@@ -0,0 +1,118 @@
+#ifndef __GRAPHBUILDER_H
+#define __GRAPHBUILDER_H
+
+#include <vector>
+#include "CycleDetector.h"
+#include "GraphStatistics.h"
+
+// forward-declarations
+class Graph;
+class State;
+class Label;
+
+/** \brief Fills a Graph with the States and Transitions read from a file.
+ *
+ * The GraphInput classes use a GraphBuilder as follows:
+ * - The constructor creates all States.
+ * - Optionally, a counting pass calls countTransitions() for all
+ *   Transitions, and then reserve(). Afterwards each State has exactly
+ *   as many Transition slots as it needs, so its vector of Transitions
+ *   never grows (and never holds twice the needed memory) while reading,
+ *   and the counted Transitions are allocated in one contiguous block. The
+ *   number of Transitions in the file header is not used for this, as it
+ *   may be wrong.
+ * - addTransition() (or markState() for a Transition labelled with the
+ *   action, see Graph::getAction()) is called for all Transitions in the
+ *   order of the file. The interactive cycles are searched (see
+ *   Graph::setCycleSearch()) and the types of the States are set.
+ * - finish() breaks the interactive cycles, if their search is deferred.
+ *
+ * Meanwhile the GraphStatistics are collected, and finish() hands them to
+ * the Graph (see Graph::setStatistics()).
+ */
+class GraphBuilder {
+  public:
+    /** \brief Constructor, creates the States
+     *
+     * @param graph         The Graph to fill, it must have no States yet
+     * @param noStates      The number of States, they are numbered from 1
+     *                      in the Graph (see State::getNumber()), but from 0
+     *                      in the methods of the GraphBuilder and in
+     *                      their origins (see State::getOrigin())
+     */
+    GraphBuilder(Graph &graph, const unsigned int &noStates);
+
+    /// Destructor
+    ~GraphBuilder();
+
+    /// Count Transitions emanating the given State (counting pass)
+    void countTransitions(const unsigned int &source,
+        const unsigned int &number = 1) {
+      counts[source] += number;
+    }
+
+    /** \brief Reserve the counted Transitions for each State
+     *
+     * Ends the counting pass, see countTransitions(). The memory for all
+     * counted Transitions is reserved in the Graph as well (see
+     * Graph::reserveTransitions()).
+     */
+    void reserve();
+
+    /// Returns the State with the given number (starting with 0)
+    State* getState(const unsigned int &state) const {
+      return states[state];
+    }
+
+    /// Mark the given State (see State::setMark())
+    void markState(const unsigned int &state);
+
+    /** \brief Add a new Transition
+     *
+     * Unless it would close an interactive cycle (and the cycles are
+     * searched while reading).
+     *
+     * @return false, if the Transition has been removed
+     */
+    bool addTransition(const unsigned int &source, const unsigned int &target,
+        Label *const &label);
+
+    /** \brief Finish reading
+     *
+     * Breaks the interactive cycles, if their search has been deferred, and
+     * warns about the removed Transitions. Sets the statistics of the Graph,
+     * unless Transitions have been removed by the deferred search.
+     *
+     * @return The number of removed Transitions
+     */
+    unsigned int finish();
+
+  private:
+    // not copyable
+    GraphBuilder(const GraphBuilder&);
+    GraphBuilder& operator=(const GraphBuilder&);
+
+    Graph &graph;
+
+    // the States of the Graph
+    std::vector<State*> &states;
+
+    // number of Transitions of each State, in the counting pass
+    std::vector<unsigned int> counts;
+
+    // search for interactive cycles while reading? (otherwise, they are
+    // searched after reading, see Graph::setDeferredCycleSearch)
+    bool onlineCycleSearch;
+
+    // the interactive Transitions read so far, for detecting cycles
+    CycleDetector interactiveTransitions;
+
+    // number of removed Transitions
+    unsigned int removed;
+
+    // the statistics of the Transitions added so far
+    GraphStatistics statistics;
+
+};
+
+#endif
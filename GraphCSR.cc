@@ -0,0 +1,73 @@
+#include "GraphCSR.h"
+#include "Transition.h"
+#include "Label.h"
+
+GraphCSR::GraphCSR()
+  : labels(NULL)
+{
+  offsets.push_back(0);
+}
+
+GraphCSR::~GraphCSR()
+{
+  // nothing to do, the States and Labels are owned by the Graph
+}
+
+void GraphCSR::build(const std::vector<State*> &states,
+    const LabelTable &labels)
+{
+  clear();
+  this->labels = &labels;
+
+  // first give each State its index and count the Transitions
+  unsigned int noTransitions(0);
+  for (std::vector<State*>::size_type i = 0; i < states.size(); ++i) {
+    states[i]->setIndex(i);
+    noTransitions += states[i]->getTransitions()->size();
+  }
+
+  offsets.reserve(states.size() + 1);
+  records.reserve(noTransitions);
+  types.reserve(states.size());
+  marks.reserve(states.size());
+  numbers.reserve(states.size());
+  origins.reserve(states.size());
+  stateObjects.reserve(states.size());
+
+  for (std::vector<State*>::const_iterator state = states.begin();
+      state != states.end(); ++state) {
+    for (std::vector<Transition*>::const_iterator trans =
+        (*state)->getTransitions()->begin();
+        trans != (*state)->getTransitions()->end(); ++trans) {
+      Record record;
+      record.target = (*trans)->getTargetState()->getIndex();
+      record.tag = labels.getTag((*trans)->getLabel()->getId());
+      records.push_back(record);
+    }
+    offsets.push_back(records.size());
+    types.push_back((*state)->getType());
+    marks.push_back((*state)->getMark());
+    numbers.push_back((*state)->getNumber());
+    origins.push_back((*state)->getOrigin());
+    stateObjects.push_back(*state);
+  }
+}
+
+void GraphCSR::clear()
+{
+  offsets.clear();
+  offsets.push_back(0);
+  records.clear();
+  types.clear();
+  marks.clear();
+  numbers.clear();
+  origins.clear();
+  stateObjects.clear();
+}
+
+void GraphCSR::setNumber(const unsigned int &state,
+    const unsigned int &newNumber)
+{
+  numbers[state] = newNumber;
+  stateObjects[state]->setNumber(newNumber);
+}
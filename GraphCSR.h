@@ -0,0 +1,196 @@
+#ifndef __GRAPHCSR_H
+#define __GRAPHCSR_H
+
+#include <vector>
+#include <cassert>
+#include "State.h"
+#include "LabelTable.h"
+
+/** \brief Compressed sparse row (CSR) read cache of a Graph.
+ *
+ * The GraphCSR is a copy of a Graph for the passes that sweep over all
+ * Transitions without modifying them. The State and Transition objects
+ * stay the storage of the Graph: the GraphInput classes, the computation
+ * of the markov successors and the transformation write into them, and a
+ * GraphCSR is only built from them afterwards. While a GraphCSR exists,
+ * the Graph is held twice.
+ *
+ * All Transitions of the Graph are stored in contiguous arrays, ordered by
+ * their source State. The Transitions emanating the State with index s are
+ * the ones with the indices getTransitionsBegin(s) up to (but excluding)
+ * getTransitionsEnd(s). Each Transition is stored in 8 bytes: the index of
+ * the target State, and the tag of its Label (see LabelTable::getTag()),
+ * which tells the kind of the Transition and its Label number or its rate.
+ * So isInteractive(), isTau() and getRate() of the GraphCSR need neither a
+ * virtual call nor a pointer to the Label (the Transition objects still
+ * have both). The type, the mark, the number and the origin of
+ * each State are stored in per-state arrays. The Labels are referred to by
+ * their ids in the LabelTable of the Graph (see Label::getId()).
+ *
+ * The index of a State is its position in the vector of States the GraphCSR
+ * was built from (see State::getIndex()).
+ *
+ * The GraphCSR is built from the State and Transition objects by build(),
+ * and it is not updated if the objects are modified afterwards. Use
+ * Graph::getCSR() to get an up-to-date GraphCSR of a Graph.
+ */
+class GraphCSR {
+  public:
+    /// Standard constructor, creates an empty GraphCSR
+    GraphCSR();
+
+    /// Destructor
+    ~GraphCSR();
+
+    /** \brief Build the CSR arrays out of the given States.
+     *
+     * Each State gets its position in the given vector as index (see
+     * State::setIndex()). All targets of the Transitions must be contained in
+     * the given vector.
+     *
+     * @param states The States (together with their Transitions) to store
+     * @param labels The LabelTable that contains the Labels of the
+     *               Transitions, it must live as long as the GraphCSR is used
+     */
+    void build(const std::vector<State*> &states, const LabelTable &labels);
+
+    /// Delete all stored States and Transitions
+    void clear();
+
+    /// Returns the number of States
+    unsigned int getStateNumber() const {
+      return types.size();
+    }
+
+    /// Returns the number of Transitions
+    unsigned int getTransitionNumber() const {
+      return records.size();
+    }
+
+    /** \brief Returns the number of Labels
+     *
+     * This is the number of Labels in the LabelTable, i.e. an upper bound for
+     * the Label numbers (see getLabelId()). Not all of them need to be used
+     * by a Transition.
+     */
+    unsigned int getLabelNumber() const {
+      return labels->size();
+    }
+
+    /// Index of the first Transition emanating the given State
+    unsigned int getTransitionsBegin(const unsigned int &state) const {
+      return offsets[state];
+    }
+
+    /// Index behind the last Transition emanating the given State
+    unsigned int getTransitionsEnd(const unsigned int &state) const {
+      return offsets[state + 1];
+    }
+
+    /// Index of the target State of the given Transition
+    unsigned int getTarget(const unsigned int &trans) const {
+      return records[trans].target;
+    }
+
+    /** \brief Number of the Label of the given Transition
+     *
+     * This is the id of the Label (see Label::getId()), the Labels are
+     * numbered from 0 to getLabelNumber() - 1. Two Transitions have the same
+     * Label iff they have the same Label number.
+     */
+    unsigned int getLabelId(const unsigned int &trans) const {
+      const unsigned int tag = records[trans].tag;
+      if (tag & LabelTable::interactiveTag)
+        return tag & LabelTable::indexMask;
+      return labels->getRateLabelId(tag);
+    }
+
+    /// Returns the Label of the given Transition
+    Label* getLabel(const unsigned int &trans) const {
+      return labels->get(getLabelId(trans));
+    }
+
+    /// Returns the Label with the given Label number
+    Label* getLabelById(const unsigned int &labelId) const {
+      return labels->get(labelId);
+    }
+
+    /// Is the given Transition interactive? (see Transition::isInteractive())
+    bool isInteractive(const unsigned int &trans) const {
+      return (records[trans].tag & LabelTable::interactiveTag) != 0;
+    }
+
+    /// Is the given Transition a tau Transition? (see Transition::isTau())
+    bool isTau(const unsigned int &trans) const {
+      return (records[trans].tag & LabelTable::tauTag) != 0;
+    }
+
+    /// Extract the rate of the given markov Transition.
+    double getRate(const unsigned int &trans) const {
+      // can only be called for a markov Transition
+      assert(!isInteractive(trans));
+      return labels->getRate(records[trans].tag);
+    }
+
+    /// Returns the type of the given State
+    State::stateType getType(const unsigned int &state) const {
+      return static_cast<State::stateType>(types[state]);
+    }
+
+    /// Returns, if the given State is marked
+    bool getMark(const unsigned int &state) const {
+      return marks[state];
+    }
+
+    /// Returns the number of the given State (see State::getNumber())
+    unsigned int getNumber(const unsigned int &state) const {
+      return numbers[state];
+    }
+
+    /// Returns the origin of the given State (see State::getOrigin())
+    unsigned int getOrigin(const unsigned int &state) const {
+      return origins[state];
+    }
+
+    /** \brief Sets the number of the given State
+     *
+     * The number is also set in the State object, so that both
+     * representations stay consistent.
+     */
+    void setNumber(const unsigned int &state, const unsigned int &newNumber);
+
+    /// Returns the State object with the given index
+    State* getState(const unsigned int &state) const {
+      return stateObjects[state];
+    }
+
+  private:
+
+    // offsets[s] is the index of the first Transition emanating State s,
+    // offsets[getStateNumber()] is the number of Transitions
+    std::vector<unsigned int> offsets;
+
+    // a Transition: the index of its target State and the tag of its Label
+    struct Record {
+      unsigned int target;
+      unsigned int tag;
+    };
+
+    // the Transitions
+    std::vector<Record> records;
+
+    // the Labels by their number
+    const LabelTable* labels;
+
+    // per-state attributes
+    std::vector<unsigned char> types;
+    std::vector<bool> marks;
+    std::vector<unsigned int> numbers;
+    std::vector<unsigned int> origins;
+
+    // the State objects, the CSR has been built from
+    std::vector<State*> stateObjects;
+
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef __GRAPHGENERATOR_H
+#define __GRAPHGENERATOR_H
+
+#include <string>
+
+/** \brief A model that generates its IMC on the fly.
+ *
+ * Instead of writing the IMC of a model to a file and reading it back, a
+ * generator can hand out its states and transitions directly, they are
+ * explored by GraphInputGenerator.
+ *
+ * A state is represented by an arbitrary string of bytes (the state vector
+ * of the generator), two states are the same if their strings are equal.
+ * The labels of the transitions are handled like the labels of a BCG file
+ * (see GraphInputBCG and Label::create()), i.e. labels containing "rate " are
+ * markov labels, and the transitions labelled with the action (see
+ * Graph::getAction()) mark their source State.
+ */
+class GraphGenerator {
+  public:
+    /// Receives the transitions emanating a state, see getSuccessors()
+    class Successors {
+      public:
+        /// Add the transition with the given label to the given state
+        virtual void add(const std::string &label,
+            const std::string &target) = 0;
+
+      protected:
+        /// Destructor
+        virtual ~Successors() {}
+    };
+
+    /** \brief Prepare the generation
+     *
+     * Called before the exploration with the part of the input filename
+     * behind the format (e.g. "N=3" for "-i mymodel:N=3"), which may be
+     * used for the parameters of the model.
+     *
+     * @return false, if the parameters are not valid
+     */
+    virtual bool initialize(const std::string &) {
+      return true;
+    }
+
+    /// Returns the initial state
+    virtual std::string getInitialState() = 0;
+
+    /// Calls successors.add() for each transition emanating the given state
+    virtual void getSuccessors(const std::string &state,
+        Successors &successors) = 0;
+
+    /// Destructor
+    virtual ~GraphGenerator() {}
+
+};
+
+#endif
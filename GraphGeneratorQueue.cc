@@ -0,0 +1,64 @@
+#include "GraphGeneratorQueue.h"
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include "Graph.h"
+
+GraphGeneratorQueue::GraphGeneratorQueue()
+  : capacity(3)
+{
+}
+
+bool GraphGeneratorQueue::initialize(const std::string &parameters)
+{
+  capacity = 3;
+  if (parameters.empty())
+    return true;
+  if ((parameters.size() < 3) || (parameters.compare(0, 2, "N=") != 0))
+    return false;
+  char* end = NULL;
+  const long newCapacity = strtol(parameters.c_str() + 2, &end, 10);
+  if ((*end != '\0') || (newCapacity < 1) || (newCapacity > 1000000))
+    return false;
+  capacity = static_cast<unsigned int>(newCapacity);
+  return true;
+}
+
+std::string GraphGeneratorQueue::getInitialState()
+{
+  return encode(0, false);
+}
+
+void GraphGeneratorQueue::getSuccessors(const std::string &state,
+    Successors &successors)
+{
+  const unsigned int jobs = atoi(state.c_str() + 1);
+  const bool busy = (state[0] == 'b');
+
+  // arrival of a job
+  if (jobs < capacity)
+    successors.add("rate 2", encode(jobs + 1, busy));
+  if (busy)
+    // the served job leaves the queue
+    successors.add("rate 3", encode(jobs - 1, false));
+  else if (jobs > 0)
+    successors.add("serve", encode(jobs, true));
+
+  if ((jobs == capacity) && !Graph::getAction().empty())
+    successors.add(Graph::getAction(), state);
+}
+
+std::string GraphGeneratorQueue::encode(const unsigned int &jobs,
+    const bool &busy)
+{
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%c%u", busy ? 'b' : 'i', jobs);
+  return buffer;
+}
+
+GraphGeneratorQueue::~GraphGeneratorQueue()
+{
+  // nothing to do here
+}
+
+GraphGeneratorQueue::registerClass GraphGeneratorQueue::registerObject;
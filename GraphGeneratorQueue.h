@@ -0,0 +1,57 @@
+#ifndef __GRAPHGENERATORQUEUE_H
+#define __GRAPHGENERATORQUEUE_H
+
+#include <string>
+#include "GraphGenerator.h"
+#include "GraphInputGenerator.h"
+#include "Graph.h"
+
+/** \brief Generates the IMC of a queue with a single server
+ *
+ * Jobs arrive with rate 2 as long as less than N jobs are waiting. An idle
+ * server starts serving (the interactive action "serve"), and a job is
+ * served with rate 3, then the server is idle again. A state is the number
+ * of jobs and whether the server is busy, the initial state is the empty
+ * queue with an idle server. If an action is given (see Graph::getAction()),
+ * the states with a full queue are marked.
+ *
+ * It is available as input format "queue", e.g. "-i queue:N=5" (the
+ * capacity is 3 if it is explored without parameters). It mainly serves as
+ * example of a GraphGenerator (see GraphInputGenerator).
+ */
+class GraphGeneratorQueue : public GraphGenerator {
+  public:
+    /// Constructor
+    GraphGeneratorQueue();
+
+    /// Reads the capacity, see GraphGenerator::initialize()
+    bool initialize(const std::string &parameters);
+
+    /// see GraphGenerator::getInitialState()
+    std::string getInitialState();
+
+    /// see GraphGenerator::getSuccessors()
+    void getSuccessors(const std::string &state, Successors &successors);
+
+    /// Destructor
+    ~GraphGeneratorQueue();
+
+  private:
+    // the state vector of the given state
+    static std::string encode(const unsigned int &jobs, const bool &busy);
+
+    // the capacity of the queue
+    unsigned int capacity;
+
+    struct registerClass {
+      registerClass() {
+        Graph::registerInput("queue",
+            new GraphInputGenerator(new GraphGeneratorQueue));
+      }
+    };
+
+    static registerClass registerObject;
+
+};
+
+#endif
@@ -0,0 +1,287 @@
+#include "GraphInputAut.h"
+#include <string>
+#include <vector>
+#include <cstring>
+#include "Graph.h"
+#include "GraphBuilder.h"
+#include "TextInput.h"
+#include "TextScanner.h"
+
+// needed for GraphInputAut::readFromFile(): a transition as read from the
+// aut file, its label points into the file
+struct _GraphInputAutTransition {
+  unsigned int source, target;
+  const char* label;
+  std::string::size_type labelLength;
+
+  static bool isBlank(const char &c) {
+    return (c == ' ') || (c == '\t') || (c == '\r');
+  }
+
+  // parses the actual line of the scanner, returns false on a syntax error
+  bool parse(TextScanner &aut) {
+    aut.skipBlanks();
+    if (!aut.skip('(') || !aut.readUnsigned(source))
+      return false;
+    aut.skipBlanks();
+    if (!aut.skip(','))
+      return false;
+
+    // the label may contain commas, so the target is behind the last one
+    const char* begin = aut.getPosition();
+    const char* close = aut.getLineEnd();
+    while ((close != begin) && isBlank(close[-1]))
+      --close;
+    if ((close == begin) || (close[-1] != ')'))
+      return false;
+    const char* comma = close - 1;
+    while ((comma != begin) && (comma[-1] != ','))
+      --comma;
+    if (comma == begin)
+      return false;
+
+    // the label without the blanks and quotes around it
+    const char* end = comma - 1;
+    while ((begin != end) && isBlank(*begin))
+      ++begin;
+    while ((end != begin) && isBlank(end[-1]))
+      --end;
+    if ((end - begin >= 2) && (*begin == '"') && (end[-1] == '"')) {
+      ++begin;
+      --end;
+    }
+    label = begin;
+    labelLength = end - begin;
+
+    aut.setPosition(comma);
+    if (!aut.readUnsigned(target))
+      return false;
+    aut.skipBlanks();
+    if (!aut.skip(')'))
+      return false;
+    aut.skipBlanks();
+    return aut.atLineEnd();
+  }
+};
+
+// needed for GraphInputAut::readFromFile(): maps the label texts of the file
+// to Labels by an open-addressing hash table, so a label that has been read
+// before is found without creating a string
+struct _GraphInputAutLabels {
+  // the texts and their Labels, an empty bucket has no Label
+  std::vector<std::string> texts;
+  std::vector<Label*> labels;
+  unsigned int noEntries;
+
+  _GraphInputAutLabels() : texts(64), labels(64, NULL), noEntries(0) {}
+
+  // FNV-1a
+  static unsigned int hash(const char* text,
+      const std::string::size_type &length) {
+    unsigned int h = 2166136261u;
+    for (std::string::size_type i = 0; i < length; ++i)
+      h = (h ^ static_cast<unsigned char>(text[i])) * 16777619u;
+    return h;
+  }
+
+  // the bucket of the text, or the empty bucket where it belongs
+  unsigned int find(const char* text, const std::string::size_type &length)
+    const {
+    const unsigned int mask = texts.size() - 1;
+    unsigned int bucket = hash(text, length) & mask;
+    while ((labels[bucket] != NULL) && ((texts[bucket].size() != length)
+          || (memcmp(texts[bucket].data(), text, length) != 0)))
+      bucket = (bucket + 1) & mask;
+    return bucket;
+  }
+
+  // the Label of the text, or NULL
+  Label* get(const char* text, const std::string::size_type &length) const {
+    return labels[find(text, length)];
+  }
+
+  // sets the Label of the (new) text
+  void set(const char* text, const std::string::size_type &length,
+      Label *const &label) {
+    const unsigned int bucket = find(text, length);
+    texts[bucket].assign(text, length);
+    labels[bucket] = label;
+    // keep the load factor below 1/2
+    if (2 * ++noEntries > texts.size()) {
+      std::vector<std::string> oldTexts(2 * texts.size());
+      std::vector<Label*> oldLabels(2 * labels.size(), NULL);
+      oldTexts.swap(texts);
+      oldLabels.swap(labels);
+      for (unsigned int old = 0; old < oldLabels.size(); ++old)
+        if (oldLabels[old] != NULL) {
+          const unsigned int newBucket = find(oldTexts[old].data(),
+              oldTexts[old].size());
+          texts[newBucket].swap(oldTexts[old]);
+          labels[newBucket] = oldLabels[old];
+        }
+    }
+  }
+};
+
+Graph* GraphInputAut::readFromFile(const std::string &,
+    const std::string &filename)
+{
+  // create new Graph object
+  Graph* graph = new Graph();
+
+  TextInput autFile;
+  if (!autFile.open(filename)) {
+    graph->warn("Error opening aut file \"%s\"", filename.c_str());
+    delete graph;
+    return NULL;
+  }
+
+  // the file is parsed block by block (see TextInput), the first block
+  // begins with the header
+  const char* begin = NULL;
+  const char* end = NULL;
+  autFile.nextBlock(begin, end);
+  TextScanner aut(begin, end);
+
+  // read the header: des (<initialState>, <noTransitions>, <noStates>)
+  unsigned int initialStateNr(0), noTransitions(0), noStates(0);
+  aut.skipBlanks();
+  bool ok = aut.skip('d') && aut.skip('e') && aut.skip('s');
+  aut.skipBlanks();
+  ok = ok && aut.skip('(') && aut.readUnsigned(initialStateNr);
+  aut.skipBlanks();
+  ok = ok && aut.skip(',') && aut.readUnsigned(noTransitions);
+  aut.skipBlanks();
+  ok = ok && aut.skip(',') && aut.readUnsigned(noStates);
+  aut.skipBlanks();
+  ok = ok && aut.skip(')');
+  aut.skipBlanks();
+  if (!ok || !aut.atLineEnd()) {
+    graph->warn("Error reading first line of aut file (expected \"des (<nr>, "
+        "<nr>, <nr>)\", found \"%s\"", aut.getLine().c_str());
+    autFile.close();
+    delete graph;
+    return NULL;
+  }
+  aut.nextLine();
+  const std::string::size_type headerLength = aut.getPosition() - begin;
+
+  // output some debug information
+  graph->debug("########################################");
+  graph->debug("INPUT statistics:");
+  graph->debug("  %-23s%15d", "Number of states:", noStates);
+  graph->debug("  %-23s%15d", "Number of transitions:", noTransitions);
+  graph->debug("########################################");
+
+  // set pointer to initial state
+  if (initialStateNr >= noStates) {
+    graph->warn("Error: the initial state %d doesn't exist", initialStateNr);
+    autFile.close();
+    delete graph;
+    return NULL;
+  }
+
+  // create all states
+  GraphBuilder builder(*graph, noStates);
+  graph->setInitialState(builder.getState(initialStateNr));
+
+  const char* block = aut.getPosition();
+  unsigned int lineNumber = aut.getLineNumber();
+
+  // first pass: count the transitions of each state, so that each state
+  // reserves the memory for its transitions only once (the errors are
+  // reported in the second pass); a streamed file (see TextInput) is only
+  // read once
+  if (!autFile.isStreamed()) {
+    do {
+      for (TextScanner counter(block, end); !counter.atEnd();
+          counter.nextLine()) {
+        unsigned int source;
+        counter.skipBlanks();
+        if (counter.skip('(') && counter.readUnsigned(source)
+            && (source < noStates))
+          builder.countTransitions(source);
+      }
+    } while (autFile.nextBlock(block, end));
+    builder.reserve();
+
+    autFile.rewind();
+    autFile.nextBlock(begin, end);
+    block = begin + headerLength;
+  }
+
+  // second pass: read the transitions
+  _GraphInputAutLabels labels;
+  Label* actionLabelPtr = graph->getLabelPtr(graph->getAction(), true);
+  unsigned int read(0);
+  do {
+    for (aut = TextScanner(block, end); !aut.atEnd(); aut.nextLine()) {
+      aut.skipBlanks();
+      if (aut.atLineEnd())
+        continue;
+
+      _GraphInputAutTransition transition;
+      const char* error = NULL;
+      if (!transition.parse(aut))
+        error = "expected \"(<nr>, <label>, <nr>)\" but found";
+      else if ((transition.source >= noStates)
+          || (transition.target >= noStates))
+        error = "state number out of range in";
+      if (error != NULL) {
+        graph->warn("Error reading aut file, line nr. %d, %s \"%s\"",
+            lineNumber + aut.getLineNumber() - 1, error,
+            aut.getLine().c_str());
+        autFile.close();
+        delete graph;
+        return NULL;
+      }
+
+      ++read;
+
+      // get the label, create it if it doesn't exist
+      Label* label = labels.get(transition.label, transition.labelLength);
+      if (label == NULL) {
+        label = graph->getLabelPtr(std::string(transition.label,
+              transition.labelLength), true);
+        labels.set(transition.label, transition.labelLength, label);
+      }
+
+      // if label is 'theAction', then just mark the State and ignore the
+      // Transition
+      if (label == actionLabelPtr) {
+        builder.markState(transition.source);
+        continue;
+      }
+
+      builder.addTransition(transition.source, transition.target, label);
+    }
+    lineNumber += aut.getLineNumber() - 1;
+  } while (autFile.nextBlock(block, end));
+
+  if (autFile.failed()) {
+    graph->warn("Error reading aut file \"%s\"",
+        autFile.getFilename().c_str());
+    autFile.close();
+    delete graph;
+    return NULL;
+  }
+
+  if (read != noTransitions)
+    graph->warn("Warning: Number of read transitions differs from specification"
+        " in the first line. Expected: %d, read: %d", noTransitions, read);
+
+  // break the interactive cycles now, if the search has been deferred
+  builder.finish();
+
+  // close input file
+  autFile.close();
+
+  return graph;
+}
+
+GraphInputAut::~GraphInputAut()
+{
+  // nothing to do here
+}
+
+GraphInputAut::registerClass GraphInputAut::registerObject;
@@ -0,0 +1,49 @@
+#ifndef __GRAPHINPUTAUT_H
+#define __GRAPHINPUTAUT_H
+
+#include <string>
+#include "GraphInput.h"
+#include "Graph.h"
+
+/** \brief Suitable for reading a Graph from an Aldebaran (".aut") file
+ *
+ * The Aldebaran format is the textual format of labelled transition systems
+ * of CADP (see also http://cadp.inria.fr/man/aut.html), but it is read
+ * without the CADP libraries. The file has the header
+ * \verbatim
+ *    des (<initialState>, <noTransitions>, <noStates>)           \endverbatim
+ * followed by one line per Transition
+ * \verbatim
+ *    (<sourceState>, <label>, <targetState>)                     \endverbatim
+ * where the States are numbered from 0, and the label may be enclosed in
+ * double-quotes. The labels are handled like the ones of a BCG file (see
+ * GraphInputBCG and Label::create()), i.e. labels containing "rate " are
+ * markov labels, and the transitions labelled with the action (see
+ * Graph::getAction()) mark their source State.
+ *
+ * The file is parsed directly from the memory it is mapped to, or from the
+ * buffers it is streamed into if it is gzip-compressed, a pipe or standard
+ * input (the filename "-", see TextInput and TextScanner).
+ */
+class GraphInputAut : public GraphInput {
+  public:
+    /// see GraphInput::readFromFile
+    Graph* readFromFile(const std::string &format,
+        const std::string &filename);
+
+    /// Destructor
+    ~GraphInputAut();
+
+  private:
+
+    struct registerClass {
+      registerClass() {
+        Graph::registerInput("aut", new GraphInputAut);
+      }
+    };
+
+    static registerClass registerObject;
+
+};
+
+#endif
@@ -3,8 +3,7 @@
 #include <cassert>
 #include <bcg_user.h>
 #include "Graph.h"
-#include "State.h"
-#include "Transition.h"
+#include "GraphBuilder.h"
 
 Graph* GraphInputBCG::readFromFile(const std::string &,
     const std::string &filename)
@@ -44,19 +43,12 @@ Graph* GraphInputBCG::readFromFile(const std::string &,
   graph->setComment(bcg_comment);
   comment.clear();
 
-  // reserve memory for all states
-  std::vector<State*> &states = *graph->getStates();
-  states.resize(noStates);
-  unsigned int nr = 0;
-  for (std::vector<State*>::iterator it = states.begin();
-      it != states.end(); ++it) {
-    *it = new State();
-    (*it)->setNumber(++nr);
-  }
+  // create all states
+  GraphBuilder builder(*graph, noStates);
 
   // set pointer to initial state
   assert(BCG_OT_INITIAL_STATE (bcg_graph) < noStates);
-  graph->setInitialState(states[BCG_OT_INITIAL_STATE(bcg_graph)]);
+  graph->setInitialState(builder.getState(BCG_OT_INITIAL_STATE(bcg_graph)));
 
   // store label pointers by label numbers (for better performance, because
   // you don't have to ask the BCG every time)
@@ -65,24 +57,26 @@ Graph* GraphInputBCG::readFromFile(const std::string &,
   // get the label pointer for 'theAction'
   Label* actionLabelPtr = graph->getLabelPtr(graph->getAction(), true);
 
-  // read all transitions from particular state and decide if Markov or
-  // Interactive
-  // all transitions and states are stored in memory
-  
   BCG_TYPE_STATE_NUMBER bcg_state_1, bcg_state_2;
   BCG_TYPE_LABEL_NUMBER bcg_label_number;
 
-  unsigned int removed(0);
+  // first pass: count the transitions of each state, so that each state
+  // reserves the memory for its transitions only once
+  BCG_OT_ITERATE_PLN (bcg_graph, bcg_state_1, bcg_label_number, bcg_state_2) {
+    assert(bcg_state_1 < noStates);
+    builder.countTransitions(bcg_state_1);
+  } BCG_OT_END_ITERATE;
+  builder.reserve();
 
+  // second pass: read all transitions from particular state and decide if
+  // Markov or Interactive
+  // all transitions and states are stored in memory
   BCG_OT_ITERATE_PLN (bcg_graph, bcg_state_1, bcg_label_number, bcg_state_2) {
 
     assert(bcg_state_1 < noStates);
     assert(bcg_state_2 < noStates);
     assert(bcg_label_number < noLabels);
 
-    State *&targetState = states[bcg_state_2],
-          *&sourceState = states[bcg_state_1];
-
     // get transition label
     Label** labelPtr = &labels[bcg_label_number];
     if (!*labelPtr)
@@ -91,47 +85,16 @@ Graph* GraphInputBCG::readFromFile(const std::string &,
 
     // if label is 'theAction', then just mark the State and ignore the Transition
     if (*labelPtr == actionLabelPtr) {
-      sourceState->setMark(true);
-      continue;
-    }
-
-    // memory for the new transition
-    // set label and target state
-    Transition* newTransition = new Transition(targetState, *labelPtr);
-
-    // prove that the new Transition doesn't cause an interactive cycle
-    if (newTransition->isInteractive()
-        && graph->getCycleSearch()
-        && graph->reachable(targetState, sourceState, true)) {
-      #ifdef DEBUG
-      std::vector<Transition*> cycle = graph->getPath(targetState,
-          sourceState, true);
-      cycle.push_back(newTransition);
-      printf("Deleting Transition \"%s\" from %d to %d because of this "
-          "cycle:\n   %d", newTransition->getLabel()->str().c_str(),
-          sourceState->getNumber(), targetState->getNumber(),
-          targetState->getNumber());
-      for (std::vector<Transition*>::iterator it = cycle.begin();
-          it != cycle.end(); ++it)
-        printf(" --%s--> %d", (*it)->getLabel()->str().c_str(),
-            (*it)->getTargetState()->getNumber());
-      printf("\n");
-      #endif
-      delete newTransition;
-      ++removed;
+      builder.markState(bcg_state_1);
       continue;
     }
 
-    // determine state type
-    sourceState->determineStateType(newTransition);
-    
-    // add transition to state
-    sourceState->addTransition(newTransition);
+    builder.addTransition(bcg_state_1, bcg_state_2, *labelPtr);
 
   } BCG_OT_END_ITERATE;
 
-  if (removed > 0)
-    graph->warn("%d transitions removed because they would have caused interactive cycles", removed);
+  // break the interactive cycles now, if the search has been deferred
+  builder.finish();
 
   // close input file
   BCG_OT_READ_BCG_END (&bcg_graph);
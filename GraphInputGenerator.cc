@@ -0,0 +1,213 @@
+#include "GraphInputGenerator.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <cstring>
+#include "Graph.h"
+#include "GraphBuilder.h"
+
+// needed for GraphInputGenerator::explore(): the state vectors of the
+// explored states, one after the other in one buffer, and an open-addressing
+// hash table of their numbers
+struct _GraphInputGeneratorStates {
+  std::vector<char> data;
+  // the beginning of each state in data, and behind the last one
+  std::vector<std::string::size_type> offsets;
+  std::vector<unsigned int> hashes;
+  // the numbers of the states, ~0u in an empty bucket
+  std::vector<unsigned int> buckets;
+
+  _GraphInputGeneratorStates() : offsets(1, 0), buckets(64, ~0u) {}
+
+  unsigned int size() const {
+    return hashes.size();
+  }
+
+  // the state vector of the state
+  std::string get(const unsigned int &state) const {
+    return std::string(data.begin() + offsets[state],
+        data.begin() + offsets[state + 1]);
+  }
+
+  // FNV-1a
+  static unsigned int hash(const std::string &state) {
+    unsigned int h = 2166136261u;
+    for (std::string::size_type i = 0; i < state.size(); ++i)
+      h = (h ^ static_cast<unsigned char>(state[i])) * 16777619u;
+    return h;
+  }
+
+  // the bucket of the state, or the empty bucket where it belongs
+  unsigned int find(const std::string &state, const unsigned int &h) const {
+    const unsigned int mask = buckets.size() - 1;
+    unsigned int bucket = h & mask;
+    for (; buckets[bucket] != ~0u; bucket = (bucket + 1) & mask) {
+      const unsigned int other = buckets[bucket];
+      if ((hashes[other] == h)
+          && (offsets[other + 1] - offsets[other] == state.size())
+          && (state.empty() || (memcmp(&data[0] + offsets[other],
+                state.data(), state.size()) == 0)))
+        break;
+    }
+    return bucket;
+  }
+
+  // the number of the state, a new state gets the next number
+  unsigned int insert(const std::string &state) {
+    const unsigned int h = hash(state);
+    const unsigned int bucket = find(state, h);
+    if (buckets[bucket] != ~0u)
+      return buckets[bucket];
+
+    const unsigned int number = size();
+    buckets[bucket] = number;
+    data.insert(data.end(), state.begin(), state.end());
+    offsets.push_back(data.size());
+    hashes.push_back(h);
+
+    // keep the load factor below 1/2
+    if (2 * size() > buckets.size()) {
+      std::vector<unsigned int>(2 * buckets.size(), ~0u).swap(buckets);
+      const unsigned int mask = buckets.size() - 1;
+      for (unsigned int other = 0; other < size(); ++other) {
+        unsigned int b = hashes[other] & mask;
+        while (buckets[b] != ~0u)
+          b = (b + 1) & mask;
+        buckets[b] = other;
+      }
+    }
+    return number;
+  }
+};
+
+// needed for GraphInputGenerator::explore(): a transition as explored
+struct _GraphInputGeneratorTransition {
+  unsigned int source, target;
+  Label* label;
+};
+
+// needed for GraphInputGenerator::explore(): collects the successors of a
+// state, and numbers their targets
+struct _GraphInputGeneratorSuccessors : public GraphGenerator::Successors {
+  Graph &graph;
+  _GraphInputGeneratorStates &states;
+  // the Labels of the label texts
+  std::map<std::string, Label*> labels;
+  Label* actionLabelPtr;
+
+  // the explored state, and the results
+  unsigned int source;
+  std::vector<_GraphInputGeneratorTransition> transitions;
+  std::vector<unsigned int> markedStates;
+
+  _GraphInputGeneratorSuccessors(Graph &graph,
+      _GraphInputGeneratorStates &states)
+    : graph(graph), states(states),
+      actionLabelPtr(graph.getLabelPtr(graph.getAction(), true)), source(0) {}
+
+  // defined out of line, it frees the explored transitions
+  ~_GraphInputGeneratorSuccessors();
+
+  void add(const std::string &label, const std::string &target) {
+    // get the label, create it if it doesn't exist
+    std::map<std::string, Label*>::iterator labelPtr = labels.find(label);
+    if (labelPtr == labels.end())
+      labelPtr = labels.insert(std::make_pair(label,
+            graph.getLabelPtr(label, true))).first;
+
+    _GraphInputGeneratorTransition transition;
+    transition.source = source;
+    transition.target = states.insert(target);
+    transition.label = labelPtr->second;
+
+    // if label is 'theAction', then just mark the State (its target is
+    // explored anyway, like the target of a marking transition in a file is
+    // a State of the Graph)
+    if (transition.label == actionLabelPtr)
+      markedStates.push_back(source);
+    else
+      transitions.push_back(transition);
+  }
+};
+
+_GraphInputGeneratorSuccessors::~_GraphInputGeneratorSuccessors()
+{
+  // nothing to do here
+}
+
+GraphInputGenerator::GraphInputGenerator(GraphGenerator* generator)
+  : generator(generator)
+{
+}
+
+Graph* GraphInputGenerator::readFromFile(const std::string &format,
+    const std::string &filename)
+{
+  if (!generator->initialize(filename)) {
+    Graph::warn("Error initializing the generator of \"%s\" with \"%s\"",
+        format.c_str(), filename.c_str());
+    return NULL;
+  }
+  return explore(*generator);
+}
+
+Graph* GraphInputGenerator::explore(GraphGenerator &generator)
+{
+  // create new Graph object
+  Graph* graph = new Graph();
+
+  // explore the states in the order they are found (breadth-first), the
+  // initial state gets number 0
+  _GraphInputGeneratorStates states;
+  _GraphInputGeneratorSuccessors successors(*graph, states);
+  states.insert(generator.getInitialState());
+  for (; successors.source < states.size(); ++successors.source)
+    generator.getSuccessors(states.get(successors.source), successors);
+
+  const unsigned int noStates = states.size();
+  const std::vector<_GraphInputGeneratorTransition> &transitions =
+    successors.transitions;
+
+  // output some debug information
+  graph->debug("########################################");
+  graph->debug("INPUT statistics:");
+  graph->debug("  %-23s%15d", "Number of states:", noStates);
+  graph->debug("  %-23s%15d", "Number of transitions:",
+      static_cast<unsigned int>(transitions.size()
+        + successors.markedStates.size()));
+  graph->debug("########################################");
+
+  // the state vectors aren't needed anymore
+  std::vector<char>().swap(states.data);
+  std::vector<unsigned int>().swap(states.buckets);
+
+  // create all states, each one reserves the memory for exactly its
+  // transitions
+  GraphBuilder builder(*graph, noStates);
+  graph->setInitialState(builder.getState(0));
+  for (std::vector<_GraphInputGeneratorTransition>::const_iterator
+      transition = transitions.begin(); transition != transitions.end();
+      ++transition)
+    builder.countTransitions(transition->source);
+  builder.reserve();
+
+  for (std::vector<unsigned int>::const_iterator state =
+      successors.markedStates.begin();
+      state != successors.markedStates.end(); ++state)
+    builder.markState(*state);
+  for (std::vector<_GraphInputGeneratorTransition>::const_iterator
+      transition = transitions.begin(); transition != transitions.end();
+      ++transition)
+    builder.addTransition(transition->source, transition->target,
+        transition->label);
+
+  // break the interactive cycles now, if the search has been deferred
+  builder.finish();
+
+  return graph;
+}
+
+GraphInputGenerator::~GraphInputGenerator()
+{
+  delete generator;
+}
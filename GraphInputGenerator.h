@@ -0,0 +1,62 @@
+#ifndef __GRAPHINPUTGENERATOR_H
+#define __GRAPHINPUTGENERATOR_H
+
+#include <string>
+#include "GraphInput.h"
+#include "GraphGenerator.h"
+#include "Graph.h"
+
+/** \brief Explores the IMC of a GraphGenerator in memory
+ *
+ * Starting with the initial state, the successors of all reachable states
+ * are asked from the generator. The states are identified by a hash table
+ * of their state vectors, and numbered in the order they are found (the
+ * initial state gets number 0, see State::getOrigin()). Afterwards the Graph
+ * is built from the explored transitions (see GraphBuilder), so nothing is
+ * written to or parsed from a file.
+ *
+ * A generator is made available as input format by registering it, e.g.
+ * \verbatim
+ *    struct registerMyModel {
+ *      registerMyModel() {
+ *        Graph::registerInput("mymodel",
+ *            new GraphInputGenerator(new MyModel));
+ *      }
+ *    };
+ *    static registerMyModel registerObject;                        \endverbatim
+ * in the source file of the generator class MyModel, then
+ * "-i mymodel:N=3" explores the model with the parameters "N=3" (see
+ * GraphGenerator::initialize()). A program that uses the Graph directly
+ * calls explore() instead.
+ */
+class GraphInputGenerator : public GraphInput {
+  public:
+    /// Constructor, the generator is deleted by the destructor
+    GraphInputGenerator(GraphGenerator* generator);
+
+    /** \brief see GraphInput::readFromFile
+     *
+     * The filename is given to GraphGenerator::initialize().
+     */
+    Graph* readFromFile(const std::string &format,
+        const std::string &filename);
+
+    /** \brief Explore the IMC of the generator
+     *
+     * @return The new Graph
+     */
+    static Graph* explore(GraphGenerator &generator);
+
+    /// Destructor
+    ~GraphInputGenerator();
+
+  private:
+    // not copyable
+    GraphInputGenerator(const GraphInputGenerator&);
+    GraphInputGenerator& operator=(const GraphInputGenerator&);
+
+    GraphGenerator* generator;
+
+};
+
+#endif
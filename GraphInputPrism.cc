@@ -3,13 +3,208 @@
 #include <fstream>
 #include <sstream>
 #include <cassert>
-#include <map>
+#include <cstring>
+#include <vector>
 #include "Graph.h"
-#include "State.h"
-#include "Transition.h"
+#include "GraphBuilder.h"
+#include "TextInput.h"
+#include "TextScanner.h"
+#include "ThreadPool.h"
 
 bool streamEmpty(std::istream&);
 
+// needed for GraphInputPrism::readFromFile(): a transition as read from the
+// transitions file
+struct _GraphInputPrismTransition {
+  unsigned int source, target;
+  double rate;
+};
+
+// needed for GraphInputPrism::readFromFile(): parses chunks of whole lines
+// of the transitions file concurrently, into one buffer per chunk
+struct _GraphInputPrismParseJob : public ThreadPool::Job {
+  // size of a chunk (in bytes, it is extended to the end of its last line)
+  static const std::string::size_type chunkSize = 1 << 20;
+
+  // the text of a chunk and the result of parsing it; the parsed lines are
+  // kept in transitions / runs, by the number of the chunk, so that the
+  // Chunks themselves are never copied with their buffers
+  struct Chunk {
+    const char* begin;
+    const char* end;
+    // number of the lines parsed (including the erroneous one)
+    unsigned int noLines;
+    // the error in the chunk, if any: its message and its line (starting
+    // with 1 in the chunk)
+    const char* error;
+    unsigned int errorLine;
+  };
+
+  unsigned int noStates;
+  std::vector<Chunk> chunks;
+  // the transitions of each chunk
+  std::vector< std::vector<_GraphInputPrismTransition> > transitions;
+  // when counting: the numbers of consecutive lines of the same source
+  // state in each chunk, as (source, number) pairs
+  std::vector< std::vector< std::pair<unsigned int, unsigned int> > > runs;
+  // only count the lines of each source state (into runs)?
+  bool counting;
+
+  _GraphInputPrismParseJob(const unsigned int &n)
+    : noStates(n), counting(false) {}
+
+  // defined out of line, it frees the buffers of all chunks
+  ~_GraphInputPrismParseJob();
+
+  // splits the text from `begin` into at most `noChunks` chunks, returns
+  // the end of the last one
+  const char* split(const char* begin, const char* end,
+      const unsigned int &noChunks) {
+    chunks.resize(noChunks);
+    unsigned int chunk = 0;
+    for (; (chunk < noChunks) && (begin != end); ++chunk) {
+      const char* chunkEnd = end;
+      if (static_cast<std::string::size_type>(end - begin) > chunkSize) {
+        chunkEnd = static_cast<const char*>(memchr(begin + chunkSize, '\n',
+              end - begin - chunkSize));
+        chunkEnd = (chunkEnd != NULL) ? chunkEnd + 1 : end;
+      }
+      chunks[chunk].begin = begin;
+      chunks[chunk].end = begin = chunkEnd;
+    }
+    chunks.resize(chunk);
+    if (transitions.size() < chunk) {
+      transitions.resize(chunk);
+      runs.resize(chunk);
+    }
+    return begin;
+  }
+
+  // the text of the erroneous line of a chunk
+  std::string getErrorText(const Chunk &chunk) const {
+    TextScanner trans(chunk.begin, chunk.end);
+    while (trans.getLineNumber() < chunk.errorLine)
+      trans.nextLine();
+    return trans.getLine();
+  }
+
+  void execute(const unsigned int &chunkNr, const unsigned int &) {
+    Chunk &chunk = chunks[chunkNr];
+    std::vector<_GraphInputPrismTransition> &chunkTransitions =
+      transitions[chunkNr];
+    std::vector< std::pair<unsigned int, unsigned int> > &chunkRuns =
+      runs[chunkNr];
+    chunkTransitions.clear();
+    chunkRuns.clear();
+    chunk.error = NULL;
+    TextScanner trans(chunk.begin, chunk.end);
+    if (counting) {
+      // just read the source states, the errors are reported when parsing
+      unsigned int source;
+      for (; !trans.atEnd(); trans.nextLine())
+        if (trans.readUnsigned(source) && (source < noStates)) {
+          if (!chunkRuns.empty() && (chunkRuns.back().first == source))
+            ++chunkRuns.back().second;
+          else
+            chunkRuns.push_back(std::make_pair(source, 1u));
+        }
+      return;
+    }
+    for (; !trans.atEnd(); trans.nextLine()) {
+      _GraphInputPrismTransition transition;
+      const bool ok = trans.readUnsigned(transition.source)
+        && trans.readUnsigned(transition.target)
+        && trans.readDouble(transition.rate);
+      trans.skipBlanks();
+      if (!ok || !trans.atLineEnd())
+        chunk.error = "expected three numbers but found";
+      else if ((transition.source >= noStates)
+          || (transition.target >= noStates))
+        chunk.error = "state number out of range in";
+      if (chunk.error != NULL) {
+        chunk.errorLine = trans.getLineNumber();
+        break;
+      }
+      chunkTransitions.push_back(transition);
+    }
+    chunk.noLines = trans.getLineNumber() - (chunk.error == NULL ? 1 : 0);
+  }
+};
+
+_GraphInputPrismParseJob::~_GraphInputPrismParseJob()
+{
+  // nothing to do here
+}
+
+// needed for GraphInputPrism::readFromFile(): maps rates to Labels by an
+// open-addressing hash table, keyed by the bits of the rate
+struct _GraphInputPrismRateLabels {
+  // the rates and their Labels, an empty bucket has no Label
+  std::vector<double> rates;
+  std::vector<Label*> labels;
+  unsigned int noEntries;
+
+  _GraphInputPrismRateLabels() : rates(64), labels(64, NULL), noEntries(0) {}
+
+  // defined out of line, it frees the table
+  ~_GraphInputPrismRateLabels();
+
+  static unsigned int hash(double rate) {
+    // 0.0 and -0.0 are equal, but have different bits
+    if (rate == 0.0)
+      rate = 0.0;
+    unsigned int words[2];
+    memcpy(words, &rate, sizeof(words));
+    unsigned int h = words[0] ^ (words[1] * 0x9e3779b9u);
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+  }
+
+  // the bucket of the rate, or the empty bucket where it belongs
+  unsigned int find(const double &rate) const {
+    const unsigned int mask = rates.size() - 1;
+    unsigned int bucket = hash(rate) & mask;
+    while ((labels[bucket] != NULL) && (rates[bucket] != rate))
+      bucket = (bucket + 1) & mask;
+    return bucket;
+  }
+
+  // the Label of the rate, or NULL
+  Label* get(const double &rate) const {
+    return labels[find(rate)];
+  }
+
+  // sets the Label of the rate
+  void set(const double &rate, Label *const &label) {
+    const unsigned int bucket = find(rate);
+    if (labels[bucket] == NULL) {
+      rates[bucket] = rate;
+      ++noEntries;
+    }
+    labels[bucket] = label;
+    // keep the load factor below 1/2
+    if (2 * noEntries > rates.size()) {
+      std::vector<double> oldRates(2 * rates.size());
+      std::vector<Label*> oldLabels(2 * labels.size(), NULL);
+      oldRates.swap(rates);
+      oldLabels.swap(labels);
+      for (unsigned int old = 0; old < oldLabels.size(); ++old)
+        if (oldLabels[old] != NULL) {
+          const unsigned int newBucket = find(oldRates[old]);
+          rates[newBucket] = oldRates[old];
+          labels[newBucket] = oldLabels[old];
+        }
+    }
+  }
+};
+
+_GraphInputPrismRateLabels::~_GraphInputPrismRateLabels()
+{
+  // nothing to do here
+}
+
 Graph* GraphInputPrism::readFromFile(const std::string &,
     const std::string &filename)
 {
@@ -33,36 +228,76 @@ Graph* GraphInputPrism::readFromFile(const std::string &,
   // create new Graph object
   Graph* graph = new Graph();
 
-  // the three files
-  std::ifstream prismFile, transFile, labelsFile;
+  // the three files, the labels and transitions files are parsed block by
+  // block, directly from the memory they are mapped or inflated to (see
+  // TextInput)
+  std::ifstream prismFile;
+  TextInput transFile, labelsFile;
 
-  // open the label file and read the number of the initial state
-  labelsFile.open(labelsFilename.c_str(), std::ios::in);
+  // open the transitions file and read its first line, it contains 2
+  // numbers (#states, #transitions); the number of states is needed for
+  // checking the labels file
+  if (!transFile.open(transFilename)) {
+    graph->warn("Error opening transitions file \"%s\"", transFilename.c_str());
+    delete graph;
+    return NULL;
+  }
+
+  const char* transBegin = NULL;
+  const char* transEnd = NULL;
+  transFile.nextBlock(transBegin, transEnd);
+  TextScanner trans(transBegin, transEnd);
+
+  unsigned int noStates, noTransitions;
+  bool ok = trans.readUnsigned(noStates) && trans.readUnsigned(noTransitions);
+  trans.skipBlanks();
+  if (!ok || !trans.atLineEnd()) {
+    graph->warn("Error reading first line of transitions file (expected two "
+        "numbers, found \"%s\"", trans.getLine().c_str());
+    transFile.close();
+    delete graph;
+    return NULL;
+  }
+  trans.nextLine();
+  const std::string::size_type headerLength = trans.getPosition() - transBegin;
 
-  if (!labelsFile) {
+  // open the label file and read the number of the initial state
+  if (!labelsFile.open(labelsFilename)) {
     graph->warn("Error opening labels file \"%s\"", labelsFilename.c_str());
     delete graph;
     return NULL;
   }
 
-  std::string line;
+  // the first block begins with the header
+  const char* begin = NULL;
+  const char* end = NULL;
+  labelsFile.nextBlock(begin, end);
+  TextScanner labels(begin, end);
 
-  // read first line and get the number of the "init" attribute
-  getline(labelsFile, line);
+  PropositionTable &propositions = graph->getPropositions();
 
+  // read the first line, it declares the labels: each one is stored as
+  // proposition, by the number of its attribute
+  std::vector<unsigned int> attributePropositions;
+  std::string line(labels.getLine());
   unsigned int nrInitAttribute(0);
+  bool foundInitAttribute(false);
   {
     std::string attribute;
     bool ok(true);
 
-    // read the items of the form <nr>="<label>"
-    // and search for the label "init"
+    // read the items of the form <nr>="<label>", separated by blanks
     std::string::iterator nextChar = line.begin();
-    while (ok && (attribute != "init")) {
-      nrInitAttribute = 0;
+    while (ok) {
+      while ((nextChar != line.end()) && isspace(*nextChar))
+        ++nextChar;
+      if (nextChar == line.end())
+        break;
+      unsigned int nrAttribute = 0;
       attribute = "";
+      ok = (isdigit(*nextChar) != 0);
       while ((nextChar != line.end()) && isdigit(*nextChar)) {
-        nrInitAttribute = 10 * nrInitAttribute + *nextChar - '0';
+        nrAttribute = 10 * nrAttribute + *nextChar - '0';
         ++nextChar;
       }
       ok &= (nextChar != line.end()) && (*nextChar++ == '=');
@@ -70,54 +305,93 @@ Graph* GraphInputPrism::readFromFile(const std::string &,
       while (ok && (nextChar != line.end()) && (*nextChar != '"'))
         attribute.append(1, *nextChar++);
       ok &= (nextChar != line.end()) && (*nextChar++ == '"');
+      if (!ok)
+        break;
+
+      if (nrAttribute >= attributePropositions.size())
+        attributePropositions.resize(nrAttribute + 1, ~0u);
+      attributePropositions[nrAttribute] = propositions.add(attribute);
+      if (attribute == "init") {
+        nrInitAttribute = nrAttribute;
+        foundInitAttribute = true;
+      }
     }
 
-    if (!ok) {
+    if (!ok || !foundInitAttribute) {
       graph->warn("Error reading first line of labels file: %s", line.c_str());
+      labelsFile.close();
       delete graph;
       return NULL;
     }
-
-    // nrInitAttribute is now set correctly
   }
+  labels.nextLine();
 
-  // now read the other lines of the labels file and search for nrInitAttribute
+  graph->debug("Read %d labels from labels file", propositions.size());
 
+  // now read the other lines of the labels file
+
+  // each line has the form <state>: <attribute> [<attribute> ...]
   unsigned int initialStateNr(0);
   bool foundInitialStateNr(false);
-  while (!labelsFile.eof()) {
-    getline(labelsFile, line);
-    if (labelsFile.eof() && line.empty())
-      break;
-    std::string::size_type posColon = line.find(':');
-    bool ok = (posColon != line.npos) && (posColon != line.size() - 1);
-    if (ok) {
-      std::istringstream stateStream(line.substr(0, posColon)),
-        nrStream(line.substr(posColon+1));
-      unsigned int stateNr, attributeNr;
-      stateStream >> stateNr;
-      nrStream >> attributeNr;
-      ok &= stateStream && nrStream && streamEmpty(stateStream) &&
-        streamEmpty(nrStream);
-      if (attributeNr == nrInitAttribute) {
-        if (!foundInitialStateNr) {
-          initialStateNr = stateNr;
-          foundInitialStateNr = true;
-        } else {
-          graph->warn("Error: found second initial state in labels file, "
-              "line: %s", line.c_str());
-          labelsFile.close();
-          delete graph;
-          return NULL;
+  unsigned int lineNumber = labels.getLineNumber();
+  const char* block = labels.getPosition();
+  do {
+    for (labels = TextScanner(block, end); !labels.atEnd();
+        labels.nextLine()) {
+      unsigned int stateNr(0), attributeNr(0);
+      bool ok = labels.readUnsigned(stateNr);
+      labels.skipBlanks();
+      ok = ok && labels.skip(':') && labels.readUnsigned(attributeNr);
+      if (ok && (stateNr >= noStates)) {
+        graph->warn("Error in line %d of labels file, the state %u doesn't "
+            "exist: %s", lineNumber + labels.getLineNumber() - 1, stateNr,
+            labels.getLine().c_str());
+        labelsFile.close();
+        delete graph;
+        return NULL;
+      }
+      while (ok) {
+        // attributes not declared in the first line are ignored
+        if ((attributeNr < attributePropositions.size())
+            && (attributePropositions[attributeNr] != ~0u))
+          propositions.set(attributePropositions[attributeNr], stateNr);
+
+        if (attributeNr == nrInitAttribute) {
+          if (!foundInitialStateNr) {
+            initialStateNr = stateNr;
+            foundInitialStateNr = true;
+          } else {
+            graph->warn("Error: found second initial state in labels "
+                "file, line %d: %s", lineNumber + labels.getLineNumber() - 1,
+                labels.getLine().c_str());
+            labelsFile.close();
+            delete graph;
+            return NULL;
+          }
         }
+
+        labels.skipBlanks();
+        if (labels.atLineEnd())
+          break;
+        ok = labels.readUnsigned(attributeNr);
+      }
+      if (!ok) {
+        graph->warn("Error in line %d of labels file: %s",
+            lineNumber + labels.getLineNumber() - 1, labels.getLine().c_str());
+        labelsFile.close();
+        delete graph;
+        return NULL;
       }
     }
-    if (!ok) {
-      graph->warn("Error in line of labels file: %s", line.c_str());
-      labelsFile.close();
-      delete graph;
-      return NULL;
-    }
+    lineNumber += labels.getLineNumber() - 1;
+  } while (labelsFile.nextBlock(block, end));
+
+  if (labelsFile.failed()) {
+    graph->warn("Error reading labels file \"%s\"",
+        labelsFile.getFilename().c_str());
+    labelsFile.close();
+    delete graph;
+    return NULL;
   }
 
   // ready reading, close labelsFile
@@ -146,7 +420,7 @@ Graph* GraphInputPrism::readFromFile(const std::string &,
   // the rateLabels map contains a mapping from rates to Labels
   // for each interactive transition (remember that in the PRISM file,
   // interactive Transitions are introduced by special constants)
-  std::map<double, Label*> rateLabels;
+  _GraphInputPrismRateLabels rateLabels;
 
   unsigned int nrReadActions(0);
 
@@ -214,7 +488,7 @@ Graph* GraphInputPrism::readFromFile(const std::string &,
 
     // now we are ready: we know the number and the action label, and now
     // have to write them in the map
-    rateLabels[rate] = graph->getLabelPtr(action, true);
+    rateLabels.set(rate, graph->getLabelPtr(action, true));
 
     if (action == graph->getAction())
       actionRate = rate;
@@ -231,28 +505,6 @@ Graph* GraphInputPrism::readFromFile(const std::string &,
   // now read the transitions file
 
 
-  transFile.open(transFilename.c_str(), std::ios::in);
-  if (!transFile) {
-    graph->warn("Error opening transitions file \"%s\"", transFilename.c_str());
-    delete graph;
-    return NULL;
-  }
-
-  // read first line from transitions file
-  // this line contains 2 numbers (#states, #transitions)
-  getline(transFile, line);
-  // parse the line
-  std::istringstream lineStream(line);
-  unsigned int noStates, noTransitions;
-  lineStream >> noStates >> noTransitions;
-  if (!lineStream || !streamEmpty(lineStream)) {
-    graph->warn("Error reading first line of transitions file (expected two "
-        "numbers, found \"%s\"", line.c_str());
-    transFile.close();
-    delete graph;
-    return NULL;
-  }
-  
   // output some debug information
   graph->debug("########################################");
   graph->debug("INPUT statistics:");
@@ -260,106 +512,119 @@ Graph* GraphInputPrism::readFromFile(const std::string &,
   graph->debug("  %-23s%15d", "Number of transitions:", noTransitions);
   graph->debug("########################################");
 
-  // reserve memory for all states
-  std::vector<State*> &states = *graph->getStates();
-  states.resize(noStates);
-  unsigned int nr = 0;
-  for (std::vector<State*>::iterator it = states.begin();
-      it != states.end(); ++it) {
-    *it = new State();
-    (*it)->setNumber(++nr);
-  }
-
   // set pointer to initial state
-  assert(initialStateNr < noStates);
-  graph->setInitialState(states[initialStateNr]);
-
-  // count the number of removed and read transitions
-  unsigned int removed(0), read(0);
-
-  while (!transFile.eof()) {
-    getline(transFile, line);
-
-    if (transFile.eof() && line.empty())
-      break;
-
-    unsigned int sourceStateNr, targetStateNr;
-    double rate;
-    std::istringstream lineStream(line);
-    lineStream >> sourceStateNr >> targetStateNr >> rate;
-    if (!lineStream || !streamEmpty(lineStream)) {
-      graph->warn("Error reading transition file, line nr. %d, expected three "
-          "numbers but found \"%s\"", read+1, line.c_str());
-      transFile.close();
-      delete graph;
-      return NULL;
-    }
-
-    ++read;
-    
-    // some assertions for the read values
-    assert(sourceStateNr < noStates);
-    assert(targetStateNr < noStates);
+  if (initialStateNr >= noStates) {
+    graph->warn("Error: the initial state %d doesn't exist", initialStateNr);
+    transFile.close();
+    delete graph;
+    return NULL;
+  }
 
-    State *&sourceState = states[sourceStateNr],
-          *&targetState = states[targetStateNr];
+  // create all states
+  GraphBuilder builder(*graph, noStates);
+  graph->setInitialState(builder.getState(initialStateNr));
+
+  // count the number of read transitions
+  unsigned int read(0);
+
+  // the lines are parsed in chunks by several threads (see
+  // Graph::setThreads()), a few chunks per thread at once, and then the
+  // transitions are added in the order of the file, so the result doesn't
+  // depend on the number of threads
+  ThreadPool pool(graph->getThreads());
+  _GraphInputPrismParseJob job(noStates);
+  const unsigned int noChunks = 4 * pool.getThreadNumber();
+
+  lineNumber = trans.getLineNumber();
+  block = trans.getPosition();
+  end = transEnd;
+
+  // first pass: count the transitions of each state, so that each state
+  // reserves the memory for its transitions only once; a streamed file (see
+  // TextInput) is only read once
+  if (!transFile.isStreamed()) {
+    job.counting = true;
+    do {
+      for (const char* next = block; next != end; ) {
+        next = job.split(next, end, noChunks);
+        pool.run(job, job.chunks.size());
+
+        for (unsigned int chunk = 0; chunk < job.chunks.size(); ++chunk)
+          for (std::vector< std::pair<unsigned int, unsigned int> >::
+              const_iterator run = job.runs[chunk].begin();
+              run != job.runs[chunk].end(); ++run)
+            builder.countTransitions(run->first, run->second);
+      }
+    } while (transFile.nextBlock(block, end));
+    builder.reserve();
 
-    // if the rate is the action rate, just mark the State
-    if (rate == actionRate) {
-      states[sourceStateNr]->setMark(true);
-      continue;
-    }
+    transFile.rewind();
+    transFile.nextBlock(begin, end);
+    block = begin + headerLength;
+  }
 
-    // get the label for that rate
-    std::map<double, Label*>::const_iterator label =
-      rateLabels.find(rate);
-    // create one if it doesn't exist
-    if (label == rateLabels.end()) {
-      std::ostringstream labelString;
-      labelString << "rate " << rate;
-      label = rateLabels.insert(
-          std::make_pair(rate, graph->getLabelPtr(labelString.str(), true))).first;
-    }
+  // second pass: parse and add the transitions
+  job.counting = false;
+  do {
+    for (const char* next = block; next != end; ) {
+      next = job.split(next, end, noChunks);
+      pool.run(job, job.chunks.size());
+
+      for (unsigned int chunkNr = 0; chunkNr < job.chunks.size(); ++chunkNr) {
+        const _GraphInputPrismParseJob::Chunk &chunk = job.chunks[chunkNr];
+        for (std::vector<_GraphInputPrismTransition>::const_iterator
+            transition = job.transitions[chunkNr].begin();
+            transition != job.transitions[chunkNr].end(); ++transition) {
+          const double rate = transition->rate;
+
+          ++read;
+
+          // if the rate is the action rate, just mark the State
+          if (rate == actionRate) {
+            builder.markState(transition->source);
+            continue;
+          }
+
+          // get the label for that rate
+          Label* label = rateLabels.get(rate);
+          // create one if it doesn't exist
+          if (label == NULL) {
+            std::ostringstream labelString;
+            labelString << "rate " << rate;
+            label = graph->getLabelPtr(labelString.str(), true);
+            rateLabels.set(rate, label);
+          }
+
+          builder.addTransition(transition->source, transition->target, label);
+        }
 
-    Transition* newTransition = new Transition(targetState, label->second);
-
-    // prove that the new Transition doesn't cause an interactive cycle
-    if (newTransition->isInteractive()
-        && graph->getCycleSearch()
-        && graph->reachable(targetState, sourceState, true)) {
-      #ifdef DEBUG
-      std::vector<Transition*> cycle = graph->getPath(targetState,
-          sourceState, true);
-      cycle.push_back(newTransition);
-      printf("Deleting Transition \"%s\" from %d to %d because of this "
-          "cycle:\n   %d", newTransition->getLabel()->str().c_str(),
-          sourceState->getNumber(), targetState->getNumber(),
-          targetState->getNumber());
-      for (std::vector<Transition*>::iterator it = cycle.begin();
-          it != cycle.end(); ++it)
-        printf(" --%s--> %d", (*it)->getLabel()->str().c_str(),
-            (*it)->getTargetState()->getNumber());
-      printf("\n");
-      #endif
-      delete newTransition;
-      ++removed;
-      continue;
+        if (chunk.error != NULL) {
+          graph->warn("Error reading transition file, line nr. %d, %s \"%s\"",
+              lineNumber + chunk.errorLine - 1, chunk.error,
+              job.getErrorText(chunk).c_str());
+          transFile.close();
+          delete graph;
+          return NULL;
+        }
+        lineNumber += chunk.noLines;
+      }
     }
+  } while (transFile.nextBlock(block, end));
 
-    // determine state type
-    sourceState->determineStateType(newTransition);
-    
-    // add transition to state
-    sourceState->addTransition(newTransition);
-
+  if (transFile.failed()) {
+    graph->warn("Error reading transitions file \"%s\"",
+        transFile.getFilename().c_str());
+    transFile.close();
+    delete graph;
+    return NULL;
   }
 
   if (read != noTransitions)
     graph->warn("Warning: Number of read transitions differs from specification"
         " in the first line. Expected: %d, read: %d", noTransitions, read);
 
-  if (removed > 0)
-    graph->warn("%d transitions removed because they would have caused interactive cycles", removed);
+  // break the interactive cycles now, if the search has been deferred
+  builder.finish();
 
   // close transitions file
   transFile.close();
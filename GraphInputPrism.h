@@ -19,11 +19,19 @@
  * begin with the key word "Action". Behind the keyword, the name for the
  * interactive Transition is given (in double-quotes).
  *
- * The labels file is needed for finding the initial state.
+ * The labels file is needed for finding the initial state. All labels
+ * declared in it are read into the atomic propositions of the Graph (see
+ * Graph::getPropositions()), so they can be written to the .lab files.
  *
  * The "main file" is the transition file, because it contains all transitions
  * from one state to another. While reading this file, all interactive
  * transitions are saved with their name.
+ *
+ * The labels and the transitions file are mapped into memory (see
+ * MappedFile) and parsed directly from there (see TextScanner). The lines
+ * of the transitions file are parsed in chunks by Graph::getThreads()
+ * threads, and the transitions are added to the Graph in the order of the
+ * file.
  */
 class GraphInputPrism : public GraphInput {
   public:
@@ -0,0 +1,254 @@
+#include "GraphInputSnapshot.h"
+#include <string>
+#include <vector>
+#include <cstring>
+#include "Graph.h"
+#include "State.h"
+#include "GraphBuilder.h"
+#include "GraphSnapshot.h"
+#include "MappedFile.h"
+
+// needed for GraphInputSnapshot::readFromFile(): hands out the sections of
+// the mapped file, as arrays
+struct _GraphInputSnapshotSections {
+  const char* position;
+  const char* end;
+
+  _GraphInputSnapshotSections(const char* begin, const char* end)
+    : position(begin), end(end) {}
+
+  // the next section with `count` times `multiple` elements, NULL if the
+  // file is too short (the size is checked by divisions, so it can't
+  // overflow)
+  template <typename T>
+  const T* next(const unsigned int &count, const unsigned int &multiple = 1) {
+    if ((position == NULL) || ((count > 0) && (multiple >
+            static_cast<std::string::size_type>(end - position) / sizeof(T)
+            / count))) {
+      position = NULL;
+      return NULL;
+    }
+    const std::string::size_type size =
+      static_cast<std::string::size_type>(count) * multiple * sizeof(T),
+      padded = (size + 7) / 8 * 8;
+    if (static_cast<std::string::size_type>(end - position) < padded) {
+      position = NULL;
+      return NULL;
+    }
+    const T* section = reinterpret_cast<const T*>(position);
+    position += padded;
+    return section;
+  }
+};
+
+Graph* GraphInputSnapshot::readFromFile(const std::string &,
+    const std::string &filename)
+{
+  // create new Graph object
+  Graph* graph = new Graph();
+
+  MappedFile snapshotFile;
+  if (!snapshotFile.open(filename)) {
+    graph->warn("Error opening snapshot file \"%s\"", filename.c_str());
+    delete graph;
+    return NULL;
+  }
+
+  GraphSnapshotHeader header;
+  if (snapshotFile.size() < sizeof(header)) {
+    graph->warn("Error: \"%s\" is not a snapshot file", filename.c_str());
+    delete graph;
+    return NULL;
+  }
+  memcpy(&header, snapshotFile.begin(), sizeof(header));
+  if ((memcmp(header.magic, "IMCSNAP", 8) != 0)
+      || (header.byteOrder != 0x01020304)) {
+    graph->warn("Error: \"%s\" is not a snapshot file (or has been written on "
+        "a machine with a different byte order)", filename.c_str());
+    delete graph;
+    return NULL;
+  }
+  if (header.version != GraphSnapshotHeader::currentVersion) {
+    graph->warn("Error: snapshot file \"%s\" has version %d, expected %d",
+        filename.c_str(), header.version, GraphSnapshotHeader::currentVersion);
+    delete graph;
+    return NULL;
+  }
+
+  // each State, Transition, Label and proposition takes at least one byte
+  // of the file, so larger numbers are invalid (and the sizes computed from
+  // them can't overflow)
+  const std::string::size_type fileSize = snapshotFile.size();
+  if ((header.noStates >= fileSize) || (header.noTransitions >= fileSize)
+      || (header.noLabels >= fileSize) || (header.noPropositions >= fileSize)) {
+    graph->warn("Error reading snapshot file \"%s\": the sizes in the header "
+        "exceed the file", filename.c_str());
+    delete graph;
+    return NULL;
+  }
+
+  // output some debug information
+  graph->debug("########################################");
+  graph->debug("INPUT statistics:");
+  graph->debug("  %-23s%15d", "Number of states:", header.noStates);
+  graph->debug("  %-23s%15d", "Number of transitions:", header.noTransitions);
+  graph->debug("########################################");
+
+  _GraphInputSnapshotSections sections(snapshotFile.begin() + sizeof(header),
+      snapshotFile.end());
+  const char* comment = sections.next<char>(header.commentLength);
+  const unsigned int* labelRecords =
+    sections.next<unsigned int>(header.noLabels, 2);
+  const char* texts = sections.next<char>(header.textLength);
+  const unsigned int* offsets =
+    sections.next<unsigned int>(header.noStates + 1);
+  const unsigned int* numbers = sections.next<unsigned int>(header.noStates);
+  const unsigned int* origins = sections.next<unsigned int>(header.noStates);
+  const unsigned char* types = sections.next<unsigned char>(header.noStates);
+  const unsigned char* marks = sections.next<unsigned char>(header.noStates);
+  const unsigned int* records =
+    sections.next<unsigned int>(header.noTransitions, 2);
+  const unsigned int* nameLengths =
+    sections.next<unsigned int>(header.noPropositions);
+  std::string::size_type namesLength = 0;
+  for (unsigned int proposition = 0; (nameLengths != NULL)
+      && (proposition < header.noPropositions); ++proposition) {
+    if (nameLengths[proposition] > fileSize - namesLength) {
+      sections.position = NULL;
+      break;
+    }
+    namesLength += nameLengths[proposition];
+  }
+  const char* names = sections.next<char>(namesLength);
+  const unsigned int noWords = header.noOrigins / 32
+    + ((header.noOrigins % 32 != 0) ? 1 : 0);
+  const unsigned int* bitsets =
+    sections.next<unsigned int>(header.noPropositions, noWords);
+  const char* error = NULL;
+  if (sections.position == NULL)
+    error = "the file is too short";
+
+  // the Labels, their ids in the Graph may differ from the ones in the file
+  std::vector<Label*> labels(header.noLabels, NULL);
+  std::string::size_type textOffset = 0;
+  for (unsigned int id = 0; (error == NULL) && (id < header.noLabels); ++id) {
+    const unsigned int head = labelRecords[2 * id],
+          tail = labelRecords[2 * id + 1];
+    if (head == ~0u) {
+      if (tail > header.textLength - textOffset) {
+        error = "label text out of range";
+        break;
+      }
+      labels[id] = graph->getLabelPtr(std::string(texts + textOffset, tail));
+      textOffset += tail;
+    } else if ((head >= id) || (tail >= id))
+      error = "invalid label path";
+    else
+      labels[id] = graph->getPathLabelPtr(labels[head], labels[tail]);
+  }
+
+  // check the States and Transitions before creating them
+  if ((error == NULL) && ((offsets[0] != 0)
+        || (offsets[header.noStates] != header.noTransitions)))
+    error = "invalid transition offsets";
+  if ((error == NULL) && (header.initialState >= header.noStates))
+    error = "the initial state doesn't exist";
+  for (unsigned int state = 0; (error == NULL) && (state < header.noStates);
+      ++state)
+    if (offsets[state] > offsets[state + 1])
+      error = "invalid transition offsets";
+  for (unsigned int trans = 0;
+      (error == NULL) && (trans < header.noTransitions); ++trans)
+    if ((records[2 * trans] >= header.noStates)
+        || (records[2 * trans + 1] >= header.noLabels))
+      error = "invalid transition";
+  // the type of each State has to be the one of its Transitions (see
+  // State::determineStateType()), its number has to be unique and at most
+  // noStates (the States are numbered from 1 after reading, from 0 after
+  // Graph::numberStates()), and its origin has to be known by the
+  // propositions
+  std::vector<bool> numberUsed(error == NULL ? header.noStates + 1 : 0, false);
+  for (unsigned int state = 0; (error == NULL) && (state < header.noStates);
+      ++state) {
+    bool interactive = false, markov = false;
+    for (unsigned int trans = offsets[state]; trans < offsets[state + 1];
+        ++trans) {
+      if (labels[records[2 * trans + 1]]->isInteractive())
+        interactive = true;
+      else
+        markov = true;
+    }
+    const State::stateType type = interactive
+      ? (markov ? State::HYBRID : State::INTERACTIVE)
+      : (markov ? State::MARKOV : State::NOTDEC);
+    if (types[state] != type)
+      error = "state type doesn't match its transitions";
+    else if ((numbers[state] > header.noStates) || numberUsed[numbers[state]])
+      error = "invalid state number";
+    else if ((origins[state] != ~0u) && (origins[state] >= header.noOrigins))
+      error = "state origin out of range";
+    else
+      numberUsed[numbers[state]] = true;
+  }
+
+  if (error != NULL) {
+    graph->warn("Error reading snapshot file \"%s\": %s", filename.c_str(),
+        error);
+    snapshotFile.close();
+    delete graph;
+    return NULL;
+  }
+
+  graph->setComment(std::string(comment, header.commentLength));
+
+  // create all States, and their Transitions without searching for
+  // interactive cycles
+  {
+    GraphBuilder builder(*graph, header.noStates);
+    for (unsigned int state = 0; state < header.noStates; ++state)
+      builder.countTransitions(state, offsets[state + 1] - offsets[state]);
+    builder.reserve();
+
+    for (unsigned int state = 0; state < header.noStates; ++state) {
+      State* const newState = builder.getState(state);
+      newState->setNumber(numbers[state]);
+      newState->setOrigin(origins[state]);
+      newState->setType(static_cast<State::stateType>(types[state]));
+      newState->setMark(marks[state] != 0);
+      for (unsigned int trans = offsets[state]; trans < offsets[state + 1];
+          ++trans)
+        newState->addTransition(graph->newTransition(
+              builder.getState(records[2 * trans]),
+              labels[records[2 * trans + 1]]));
+    }
+    graph->setInitialState(builder.getState(header.initialState));
+  }
+
+  // the propositions
+  PropositionTable &propositions = graph->getPropositions();
+  for (unsigned int proposition = 0; proposition < header.noPropositions;
+      ++proposition) {
+    const unsigned int id = propositions.add(std::string(names,
+          nameLengths[proposition]));
+    names += nameLengths[proposition];
+    for (unsigned int origin = 0; origin < header.noOrigins; ++origin)
+      if (bitsets[proposition * noWords + origin / 32] & (1u << (origin % 32)))
+        propositions.set(id, origin);
+  }
+
+  // close input file
+  snapshotFile.close();
+
+  return graph;
+}
+
+GraphInputSnapshot::~GraphInputSnapshot()
+{
+  // nothing to do here
+}
+
+GraphInputSnapshot::registerClass GraphInputSnapshot::registerObject;
+
+// Graph::warn() takes its arguments by reference, so the constant needs a
+// definition
+const unsigned int GraphSnapshotHeader::currentVersion;
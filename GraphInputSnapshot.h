@@ -0,0 +1,39 @@
+#ifndef __GRAPHINPUTSNAPSHOT_H
+#define __GRAPHINPUTSNAPSHOT_H
+
+#include <string>
+#include "GraphInput.h"
+#include "Graph.h"
+
+/** \brief Suitable for reading a Graph from a binary snapshot
+ *
+ * The snapshot has been written by GraphOutputSnapshot (see
+ * GraphSnapshotHeader for the format). The file is mapped into memory (see
+ * MappedFile), and the States, Transitions and Labels are created directly
+ * from the arrays in it, nothing has to be parsed.
+ *
+ * The Graph is restored as it has been written, in particular the
+ * interactive cycles are not searched again (see Graph::setCycleSearch()).
+ */
+class GraphInputSnapshot : public GraphInput {
+  public:
+    /// see GraphInput::readFromFile
+    Graph* readFromFile(const std::string &format,
+        const std::string &filename);
+
+    /// Destructor
+    ~GraphInputSnapshot();
+
+  private:
+
+    struct registerClass {
+      registerClass() {
+        Graph::registerInput("imcsnap", new GraphInputSnapshot);
+      }
+    };
+
+    static registerClass registerObject;
+
+};
+
+#endif
@@ -0,0 +1,67 @@
+#include "GraphOutputAut.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include "GraphCSR.h"
+#include "Label.h"
+
+void GraphOutputAut::writeToFile(Graph* graph, const std::string &,
+        const std::string &filename)
+{
+  // get the Graph ready for export
+  graph->prepareForExport();
+
+  graph->debug("Writing aut file");
+  graph->debug("OUTPUT %s", filename.c_str());
+
+  const GraphCSR &states = graph->getCSR();
+
+  // open file
+  std::ofstream autFile;
+  autFile.open(filename.c_str(), std::ios::out | std::ios::trunc);
+
+  if (!autFile) {
+    graph->warn("Error opening file!");
+    return;
+  }
+
+  // the initial State has number 0 (see Graph::numberStates())
+  autFile << "des (0, " << states.getTransitionNumber() << ", "
+    << states.getStateNumber() << ")\n";
+
+  // the quoted texts of the Labels by their ids, built once per Label
+  // (the text of a LabelPath is built on each call of str())
+  std::vector<std::string> texts(states.getLabelNumber());
+  const std::string action = "\"" + graph->getAction() + "\"";
+
+  // iterate over all states
+  for (unsigned int state = 0; state < states.getStateNumber(); ++state)
+    // write all transitions emanating this state
+    for (unsigned int trans = states.getTransitionsBegin(state);
+        trans != states.getTransitionsEnd(state); ++trans) {
+      // if an interactive State is marked, then all outgoing Transitions
+      // are labelled by 'theAction' (just like in GraphOutputBCG)
+      const std::string* text = &action;
+      if (!states.getMark(state)
+          || (states.getType(state) != State::INTERACTIVE)) {
+        text = &texts[states.getLabelId(trans)];
+        if (text->empty())
+          texts[states.getLabelId(trans)] = "\""
+            + states.getLabel(trans)->str() + "\"";
+      }
+      autFile << '(' << states.getNumber(state) << ", " << *text << ", "
+        << states.getNumber(states.getTarget(trans)) << ")\n";
+    }
+
+  if (!autFile)
+    graph->warn("Warning: It seems as if there was an error while writing "
+        "aut file.");
+  autFile.close();
+}
+
+GraphOutputAut::~GraphOutputAut()
+{
+  // nothing to do
+}
+
+GraphOutputAut::registerClass GraphOutputAut::registerObject;
@@ -0,0 +1,37 @@
+#ifndef __GRAPHOUTPUTAUT_H
+#define __GRAPHOUTPUTAUT_H
+
+#include <string>
+#include "GraphOutput.h"
+#include "Graph.h"
+
+/** \brief Suitable for writing to an Aldebaran (".aut") file
+ *
+ * The Graph is written just like by GraphOutputBCG, but in the textual
+ * Aldebaran format of CADP (see GraphInputAut), so the CADP libraries are
+ * not needed. All labels are enclosed in double-quotes.
+ *
+ * This class handles the "aut" format.
+ */
+class GraphOutputAut : public GraphOutput {
+  public:
+    /// See GraphOutput::writeToFile
+    void writeToFile(Graph* graph, const std::string &format,
+        const std::string &filename);
+
+    /// Destructor
+    ~GraphOutputAut();
+
+  private:
+
+    struct registerClass {
+      registerClass() {
+        Graph::registerOutput("aut", new GraphOutputAut);
+      }
+    };
+
+    static registerClass registerObject;
+
+};
+
+#endif
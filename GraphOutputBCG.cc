@@ -1,8 +1,8 @@
 #include "GraphOutputBCG.h"
 #include <string>
 #include <bcg_user.h>
-#include "State.h"
-#include "Transition.h"
+#include "GraphCSR.h"
+#include "Label.h"
 
 void GraphOutputBCG::writeToFile(Graph* graph, const std::string &,
         const std::string &filename)
@@ -37,21 +37,21 @@ void GraphOutputBCG::writeToFile(Graph* graph, const std::string &,
   delete [] comment_char;
 
   // iterate over all states
-  std::vector<State*> &states = *graph->getStates();
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state)
+  const GraphCSR &states = graph->getCSR();
+  for (unsigned int state = 0; state < states.getStateNumber(); ++state)
     // write all transitions emanating this state
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end(); ++trans)
+    for (unsigned int trans = states.getTransitionsBegin(state);
+        trans != states.getTransitionsEnd(state); ++trans)
       // [label must be non-const (Bug in BCG! grr...)]
       // if an interactive State is marked, then all outgoing Transitions
       // are labelled by 'theAction'
-      BCG_IO_WRITE_BCG_EDGE((*state)->getNumber(),
+      BCG_IO_WRITE_BCG_EDGE(states.getNumber(state),
           const_cast<char*>(
-            ((*state)->getMark() && ((*state)->getType() == State::INTERACTIVE))
-              ? graph->getAction().c_str() : (*trans)->getLabel()->str().c_str()),
-          (*trans)->getTargetState()->getNumber());
+            (states.getMark(state)
+             && (states.getType(state) == State::INTERACTIVE))
+              ? graph->getAction().c_str()
+              : states.getLabel(trans)->str().c_str()),
+          states.getNumber(states.getTarget(trans)));
 
   BCG_IO_WRITE_BCG_END ();
 }
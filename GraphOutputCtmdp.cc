@@ -1,11 +1,10 @@
 #include "GraphOutputCtmdp.h"
 #include <string>
 #include <fstream>
-#include <set>
+#include <map>
 #include <cassert>
 #include <iomanip>
-#include "State.h"
-#include "Transition.h"
+#include "GraphCSR.h"
 #include "Label.h"
 
 void GraphOutputCtmdp::writeToFile(Graph* graph, const std::string &format,
@@ -22,16 +21,16 @@ void GraphOutputCtmdp::writeToFile(Graph* graph, const std::string &format,
   graph->debug("Dumping to %s format.", groupActions ? "CTMDPI" : "CTMDP");
   graph->debug("OUTPUT %s", filename.c_str());
 
-  std::vector<State*> &states = *graph->getStates();
+  // after prepareForExport(), the index of each State is its number
+  const GraphCSR &states = graph->getCSR();
 
   // get number of interactive States
   unsigned int nrInteractiveStates(0);
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
-    if ((*state)->getType() == State::MARKOV) {
+  for (unsigned int state = 0; state < states.getStateNumber(); ++state) {
+    if (states.getType(state) == State::MARKOV) {
 #ifndef NDEBUG
-      for (; state != states.end(); ++state)
-        assert((*state)->getType() == State::MARKOV);
+      for (; state < states.getStateNumber(); ++state)
+        assert(states.getType(state) == State::MARKOV);
 #endif
       break;
     }
@@ -52,22 +51,22 @@ void GraphOutputCtmdp::writeToFile(Graph* graph, const std::string &format,
   ctmdpFile << "STATES " << nrInteractiveStates << std::endl
     << "#DECLARATION" << std::endl;
 
-  // Set of all actions
-  std::set<std::string> allActions;
+  // all actions, by their Label number
+  // (the Labels of interactive Transitions have different strings iff they
+  // have different Label numbers)
+  std::vector<bool> allActions(states.getLabelNumber(), false);
 
   // write out all action labels and all "reach" declarations
-  unsigned int toDo = nrInteractiveStates;
-  for (std::vector<State*>::const_iterator state = states.begin();
-      toDo != 0; ++state, --toDo) {
+  for (unsigned int state = 0; state < nrInteractiveStates; ++state) {
 
     // search for new action labels
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end();
-        ++trans) {
-      const std::string action = (*trans)->getLabel()->str();
-      if (allActions.insert(action).second)
-        ctmdpFile << action << std::endl;
+    for (unsigned int trans = states.getTransitionsBegin(state);
+        trans != states.getTransitionsEnd(state); ++trans) {
+      const unsigned int action = states.getLabelId(trans);
+      if (!allActions[action]) {
+        allActions[action] = true;
+        ctmdpFile << states.getLabelById(action)->str() << std::endl;
+      }
     }
   }
   ctmdpFile << "#END" << std::endl;
@@ -79,73 +78,72 @@ void GraphOutputCtmdp::writeToFile(Graph* graph, const std::string &format,
   unsigned int leftOut = 0;
 
   // and now the main work...
-  toDo = nrInteractiveStates;
-  for (std::vector<State*>::const_iterator state = states.begin();
-      toDo != 0; ++state, --toDo) {
 
-    // in the .ctmdp-file, there is no internal nondeterminism permitted
-    // in this set, we save all seen actions emanating this state to
-    // avoid having internal nondeterminism
-    std::set<std::string> seenActions;
+  // in the .ctmdp-file, there is no internal nondeterminism permitted
+  // seenActions[l] == state + 1 iff the action with Label number l has
+  // already been seen emanating `state`
+  std::vector<unsigned int> seenActions(states.getLabelNumber(), 0);
+
+  for (unsigned int state = 0; state < nrInteractiveStates; ++state) {
 
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end();
-        ++trans) {
+    for (unsigned int trans = states.getTransitionsBegin(state);
+        trans != states.getTransitionsEnd(state); ++trans) {
 
       // the probability function to get to another state
       std::map<unsigned int, double> rates;
 
-      State* target = (*trans)->getTargetState();
+      const unsigned int target = states.getTarget(trans);
 
-      const std::string& action = (*trans)->getLabel()->str();
+      const std::string action = states.getLabel(trans)->str();
 
       // some assertions: the Transitions emanating interactive States must
       // be interactive, and their targets must be markov States
-      assert((*trans)->isInteractive());
-      assert(target->getType() == State::MARKOV);
+      assert(states.isInteractive(trans));
+      assert(states.getType(target) == State::MARKOV);
+
+      for (unsigned int mTrans = states.getTransitionsBegin(target);
+          mTrans != states.getTransitionsEnd(target); ++mTrans) {
 
-      for (std::vector<Transition*>::const_iterator mTrans =
-          target->getTransitions()->begin();
-          mTrans != target->getTransitions()->end();
-          ++mTrans) {
+        const unsigned int mTarget = states.getTarget(mTrans);
 
         // again some assertions: the Transitions emanating markov States must
         // be markov, and their targets must be interactive States
-        assert(!(*mTrans)->isInteractive());
-        assert(((*mTrans)->getTargetState()->getType() == State::INTERACTIVE)
-            || ((*mTrans)->getTargetState()->getType() == State::NOTDEC));
+        assert(!states.isInteractive(mTrans));
+        assert((states.getType(mTarget) == State::INTERACTIVE)
+            || (states.getType(mTarget) == State::NOTDEC));
 
-        assert((*mTrans)->getTargetState()->getNumber() < states.size());
+        assert(states.getNumber(mTarget) < states.getStateNumber());
 
         // add the found rate to the map of actions
-        rates[(*mTrans)->getTargetState()->getNumber()] += (*mTrans)->getRate();
+        rates[states.getNumber(mTarget)] += states.getRate(mTrans);
       }
 
       // iterate over the States that are reached by the current action
       // (reached States are unordered (out of map))
       if (groupActions) {
-        ctmdpFile << (*state)->getNumber() + stateNumberOffset << " "
+        ctmdpFile << states.getNumber(state) + stateNumberOffset << " "
           << action << std::endl;
         for (std::map<unsigned int, double>::const_iterator rate =
             rates.begin(); rate != rates.end(); ++rate)
           ctmdpFile << "* " << rate->first + stateNumberOffset << " "
             << std::setprecision(10) << rate->second << std::endl;
       } else {
-        if (!seenActions.insert(action).second) {
+        unsigned int &seen = seenActions[states.getLabelId(trans)];
+        if (seen == state + 1) {
           #ifdef DEBUG
           printf("Leaving out action \"%s\" on state %d.\n",
-              action.c_str(), (*state)->getNumber());
+              action.c_str(), states.getNumber(state));
           #endif
           leftOut++;
           continue;
         }
+        seen = state + 1;
         for (std::map<unsigned int, double>::const_iterator rate =
             rates.begin(); rate != rates.end(); ++rate) {
           
-          assert((*state)->getNumber() < states.size());
+          assert(states.getNumber(state) < states.getStateNumber());
 
-          ctmdpFile << (*state)->getNumber() + stateNumberOffset << " "
+          ctmdpFile << states.getNumber(state) + stateNumberOffset << " "
             << rate->first + stateNumberOffset << " " << action << " "
             << std::setprecision(10) << rate->second << std::endl;
         }
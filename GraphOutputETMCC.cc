@@ -2,8 +2,8 @@
 #include <string>
 #include <fstream>
 #include <cassert>
-#include "State.h"
-#include "Transition.h"
+#include "GraphCSR.h"
+#include "Label.h"
 
 void GraphOutputETMCC::writeToFile(Graph* graph, const std::string &,
         const std::string &filename)
@@ -15,7 +15,7 @@ void GraphOutputETMCC::writeToFile(Graph* graph, const std::string &,
   graph->debug("Dumping to ETMCC format.");
   graph->debug("OUTPUT %s", filename.c_str());
 
-  std::vector<State*> &states = *graph->getStates();
+  const GraphCSR &states = graph->getCSR();
 
   // open file
   std::ofstream traFile;
@@ -26,37 +26,29 @@ void GraphOutputETMCC::writeToFile(Graph* graph, const std::string &,
     return;
   }
 
-  // now we have to count the transitions (not very nice)
-  unsigned int noTransitions = 0;
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state)
-    noTransitions += (*state)->getTransitions()->size();
-
   // dump number of States/Transitions
-  traFile << "STATES " << states.size() << std::endl
-    << "TRANSITIONS " << noTransitions << std::endl << std::endl;
+  traFile << "STATES " << states.getStateNumber() << std::endl
+    << "TRANSITIONS " << states.getTransitionNumber() << std::endl << std::endl;
 
   // write Transitions
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
+  for (unsigned int state = 0; state < states.getStateNumber(); ++state) {
 
-    const bool interactiveState = ((*state)->getType() == State::INTERACTIVE);
+    const bool interactiveState = (states.getType(state) == State::INTERACTIVE);
 
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end(); ++trans) {
+    for (unsigned int trans = states.getTransitionsBegin(state);
+        trans != states.getTransitionsEnd(state); ++trans) {
 
-      assert((*trans)->isInteractive() == interactiveState);
+      assert(states.isInteractive(trans) == interactiveState);
       
       traFile
         // Prefix: 'd' for interactive Transitions, 'r' for markov Transitions
         << (interactiveState ? 'd' : 'r') << " "
         // source State number plus offset
-        << (*state)->getNumber() + stateNumberOffset << " "
+        << states.getNumber(state) + stateNumberOffset << " "
         // target State number plus offset
-        << (*trans)->getTargetState()->getNumber() + stateNumberOffset << " "
+        << states.getNumber(states.getTarget(trans)) + stateNumberOffset << " "
         // the Transition rate ("0.0" of interactive Transitions)
-        << (interactiveState ? 0.0 : (*trans)->getLabel()->getRate()) << " "
+        << (interactiveState ? 0.0 : states.getRate(trans)) << " "
         // Suffix: 'I' for interactive Transitions, 'M' for markov Transitions
         << (interactiveState ? 'I' : 'M')
         // ready, print newLine
@@ -1,11 +1,8 @@
 #include "GraphOutputLab.h"
 #include <string>
 #include <fstream>
-#include <set>
 #include <cassert>
-#include "State.h"
-#include "Transition.h"
-#include "Label.h"
+#include "GraphCSR.h"
 
 const char* GraphOutputLab::reachLabel = "reach";
 const char* GraphOutputLab::absorbingLabel = "absorbing";
@@ -19,50 +16,59 @@ void GraphOutputLab::writeToFile(Graph* graph, const std::string &,
   // get the Graph ready for export
   graph->prepareForExport();
 
-  std::vector<State*> &states = *graph->getStates();
+  const GraphCSR &states = graph->getCSR();
+  const PropositionTable &graphPropositions = graph->getPropositions();
 
   std::vector<bool> markedStates, absorbingStates;
   unsigned int absorbing = 0;
 
   bool searchAbsorbing = Graph::isSearchForAbsorbingStates();
 
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
-    const State* const &curState = *state;
-    if (curState->getType() == State::MARKOV) {
+  // the atomic propositions to write, and the origins of the States (by
+  // their numbers) to look them up
+  std::vector<unsigned int> propositions;
+  std::vector<unsigned int> origins;
+  selectPropositions(graph, propositions);
+
+  for (unsigned int state = 0; state < states.getStateNumber(); ++state) {
+    if (states.getType(state) == State::MARKOV) {
 #ifndef NDEBUG
-      for (; state != states.end(); ++state)
-        assert((*state)->getType() == State::MARKOV);
+      for (; state < states.getStateNumber(); ++state)
+        assert(states.getType(state) == State::MARKOV);
 #endif
       break;
     }
 
-    if (curState->getMark()) {
-      if (markedStates.size() <= curState->getNumber())
-        markedStates.resize(curState->getNumber() + 1);
-      markedStates[curState->getNumber()] = true;
+    const unsigned int number = states.getNumber(state);
+
+    if (states.getMark(state)) {
+      if (markedStates.size() <= number)
+        markedStates.resize(number + 1);
+      markedStates[number] = true;
+    }
+
+    if (!propositions.empty()) {
+      if (origins.size() <= number)
+        origins.resize(number + 1, ~0u);
+      origins[number] = states.getOrigin(state);
     }
 
     if (searchAbsorbing) {
       bool isAbsorbing = true;
-      for (std::vector<Transition*>::const_iterator out1 =
-          curState->getTransitions()->begin();
-          isAbsorbing && (out1 != curState->getTransitions()->end());
-          ++out1) {
-        State* target1 = (*out1)->getTargetState();
-        for (std::vector<Transition*>::const_iterator out2 =
-            target1->getTransitions()->begin();
-            out2 != target1->getTransitions()->end();
-            ++out2)
-          if ((*out2)->getTargetState() != curState) {
+      for (unsigned int out1 = states.getTransitionsBegin(state);
+          isAbsorbing && (out1 != states.getTransitionsEnd(state)); ++out1) {
+        const unsigned int target1 = states.getTarget(out1);
+        for (unsigned int out2 = states.getTransitionsBegin(target1);
+            out2 != states.getTransitionsEnd(target1); ++out2)
+          if (states.getTarget(out2) != state) {
             isAbsorbing = false;
             break;
           }
       }
       if (isAbsorbing) {
-        if (absorbingStates.size() <= curState->getNumber())
-          absorbingStates.resize(curState->getNumber() + 1);
-        absorbingStates[curState->getNumber()] = true;
+        if (absorbingStates.size() <= number)
+          absorbingStates.resize(number + 1);
+        absorbingStates[number] = true;
         absorbing++;
       }
     }
@@ -86,22 +92,39 @@ void GraphOutputLab::writeToFile(Graph* graph, const std::string &,
           << reachLabel << std::endl;
   if (absorbing > 0)
     labFile << absorbingLabel << std::endl;
+  for (std::vector<unsigned int>::const_iterator proposition =
+      propositions.begin(); proposition != propositions.end(); ++proposition)
+    labFile << graphPropositions.getName(*proposition) << std::endl;
   labFile << "#END" << std::endl;
 
   unsigned int max = markedStates.size();
   if (absorbingStates.size() > max)
     max = absorbingStates.size();
+  if (origins.size() > max)
+    max = origins.size();
 
   for (unsigned int i = 0; i < max; ++i) {
     bool isMarked    = (i <    markedStates.size()) &&    markedStates[i];
     bool isAbsorbing = (i < absorbingStates.size()) && absorbingStates[i];
+    const unsigned int origin = (i < origins.size()) ? origins[i] : ~0u;
+
+    bool isLabelled = isMarked || isAbsorbing;
+    for (std::vector<unsigned int>::const_iterator proposition =
+        propositions.begin(); !isLabelled && (proposition !=
+          propositions.end()); ++proposition)
+      isLabelled = graphPropositions.holds(*proposition, origin);
 
-    if (isMarked || isAbsorbing) {
+    if (isLabelled) {
       labFile << i + stateNumberOffset;
       if (isMarked)
         labFile << " " << reachLabel;
       if (isAbsorbing)
         labFile << " " << absorbingLabel;
+      for (std::vector<unsigned int>::const_iterator proposition =
+          propositions.begin(); proposition != propositions.end();
+          ++proposition)
+        if (graphPropositions.holds(*proposition, origin))
+          labFile << " " << graphPropositions.getName(*proposition);
       labFile << std::endl;
     }
   }
@@ -112,6 +135,41 @@ void GraphOutputLab::writeToFile(Graph* graph, const std::string &,
 
 }
 
+void GraphOutputLab::selectPropositions(Graph* graph,
+    std::vector<unsigned int> &propositions)
+{
+  const PropositionTable &graphPropositions = graph->getPropositions();
+  const std::vector<std::string> &names = Graph::getLabPropositions();
+  std::vector<bool> selected(graphPropositions.size(), false);
+
+  for (std::vector<std::string>::const_iterator name = names.begin();
+      name != names.end(); ++name) {
+    if (*name == "all") {
+      selected.assign(selected.size(), true);
+      continue;
+    }
+    unsigned int proposition;
+    if (!graphPropositions.find(*name, proposition))
+      graph->warn("Warning: The input file has no label \"%s\"",
+          name->c_str());
+    else
+      selected[proposition] = true;
+  }
+
+  // the labels of the lab file itself can't be written twice
+  for (unsigned int proposition = 0; proposition < selected.size();
+      ++proposition) {
+    if (!selected[proposition])
+      continue;
+    const std::string &name = graphPropositions.getName(proposition);
+    if ((name == reachLabel) || (name == absorbingLabel))
+      graph->warn("Warning: The label \"%s\" of the input file is not "
+          "written to the lab file", name.c_str());
+    else
+      propositions.push_back(proposition);
+  }
+}
+
 GraphOutputLab::~GraphOutputLab()
 {
   // nothing to do
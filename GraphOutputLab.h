@@ -2,6 +2,7 @@
 #define __GRAPHOUTPUTLAB_H
 
 #include <string>
+#include <vector>
 #include "GraphOutput.h"
 #include "Graph.h"
 
@@ -20,18 +21,24 @@
  * the same State.
  * If no such States exist, the label will not be deklared.
  *
+ * Additionally, the atomic propositions of the input file (see
+ * Graph::getPropositions()) given by Graph::getLabPropositions() are
+ * written, with their names as labels.
+ *
  * This file has the header
  * \verbatim
  *    #DECLARATION
  *    reach
  *    absorbing
+ *    <proposition>
+ *    ...
  *    #END                                                        \endverbatim
  * Where absorbing is only introduces, if there is at least one absorbing State.
  *
  * The following lines have the form
  * \verbatim
- *    <stateNr> <label> [<label>]                                 \endverbatim
- * Where label may be one of "reach" and "absorbing".
+ *    <stateNr> <label> [<label> ...]                             \endverbatim
+ * Where label may be one of "reach", "absorbing" and the propositions.
  *
  * This class handles the "lab" format.
  */
@@ -55,6 +62,11 @@ class GraphOutputLab : public GraphOutput {
 
     static registerClass registerObject;
 
+    // stores the numbers of the propositions to write (see
+    // Graph::getLabPropositions()), warns about the unknown ones
+    static void selectPropositions(Graph* graph,
+        std::vector<unsigned int> &propositions);
+
     static const unsigned short stateNumberOffset = 1;
 
     static const char* reachLabel;
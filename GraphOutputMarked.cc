@@ -2,8 +2,7 @@
 #include <string>
 #include <fstream>
 #include <cassert>
-#include "State.h"
-#include "Transition.h"
+#include "GraphCSR.h"
 
 void GraphOutputMarked::writeToFile(Graph* graph, const std::string &,
         const std::string &filename)
@@ -11,16 +10,15 @@ void GraphOutputMarked::writeToFile(Graph* graph, const std::string &,
   // get the Graph ready for export
   graph->prepareForExport();
 
-  std::vector<State*> &states = *graph->getStates();
+  const GraphCSR &states = graph->getCSR();
 
   // get number of interactive States
   unsigned int nrInteractiveStates(0);
-  for (std::vector<State*>::const_iterator state = states.begin();
-      state != states.end(); ++state) {
-    if ((*state)->getType() == State::MARKOV) {
+  for (unsigned int state = 0; state < states.getStateNumber(); ++state) {
+    if (states.getType(state) == State::MARKOV) {
 #ifndef NDEBUG
-      for (; state != states.end(); ++state)
-        assert((*state)->getType() == State::MARKOV);
+      for (; state < states.getStateNumber(); ++state)
+        assert(states.getType(state) == State::MARKOV);
 #endif
       break;
     }
@@ -37,10 +35,9 @@ void GraphOutputMarked::writeToFile(Graph* graph, const std::string &,
   }
 
   // iterate over States and write out the marked ones
-  for (std::vector<State*>::const_iterator state = states.begin();
-      nrInteractiveStates != 0; ++state, --nrInteractiveStates)
-    if ((*state)->getMark())
-      markedFile << (*state)->getNumber() << std::endl;
+  for (unsigned int state = 0; state < nrInteractiveStates; ++state)
+    if (states.getMark(state))
+      markedFile << states.getNumber(state) << std::endl;
 
   if (!markedFile)
     graph->warn("Warning: It seems as if there was an error while writing "
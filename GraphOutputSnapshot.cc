@@ -0,0 +1,134 @@
+#include "GraphOutputSnapshot.h"
+#include <string>
+#include <vector>
+#include <cstring>
+#include "GraphCSR.h"
+#include "GraphSnapshot.h"
+
+void GraphOutputSnapshot::writeToFile(Graph* graph, const std::string &,
+        const std::string &filename)
+{
+  graph->debug("Writing snapshot file.");
+  graph->debug("OUTPUT %s", filename.c_str());
+
+  const GraphCSR &states = graph->getCSR();
+  const LabelTable &labels = graph->getLabels();
+  const PropositionTable &propositions = graph->getPropositions();
+
+  GraphSnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, "IMCSNAP", 8);
+  header.version = GraphSnapshotHeader::currentVersion;
+  header.byteOrder = 0x01020304;
+  header.noStates = states.getStateNumber();
+  header.noTransitions = states.getTransitionNumber();
+  header.noLabels = labels.size();
+  header.noPropositions = propositions.size();
+  header.initialState = (graph->getInitialState() != NULL)
+    ? graph->getInitialState()->getIndex() : ~0u;
+  header.commentLength = graph->getComment().size();
+
+  // the Labels and their texts
+  std::vector<unsigned int> labelRecords;
+  std::string texts;
+  labelRecords.reserve(2 * labels.size());
+  for (unsigned int id = 0; id < labels.size(); ++id) {
+    const LabelPath* path = dynamic_cast<LabelPath*>(labels.get(id));
+    if (path != NULL) {
+      labelRecords.push_back(path->getHead()->getId());
+      labelRecords.push_back(path->getTail()->getId());
+    } else {
+      const std::string text = labels.getText(id);
+      labelRecords.push_back(~0u);
+      labelRecords.push_back(text.size());
+      texts.append(text);
+    }
+  }
+  header.textLength = texts.size();
+
+  // the States and their Transitions
+  std::vector<unsigned int> offsets(header.noStates + 1),
+    numbers(header.noStates), origins(header.noStates),
+    records(2 * header.noTransitions);
+  std::vector<unsigned char> types(header.noStates), marks(header.noStates);
+  for (unsigned int state = 0; state < header.noStates; ++state) {
+    offsets[state] = states.getTransitionsBegin(state);
+    numbers[state] = states.getNumber(state);
+    origins[state] = states.getOrigin(state);
+    types[state] = states.getType(state);
+    marks[state] = states.getMark(state);
+    if ((origins[state] != ~0u) && (origins[state] >= header.noOrigins))
+      header.noOrigins = origins[state] + 1;
+  }
+  offsets[header.noStates] = header.noTransitions;
+  for (unsigned int trans = 0; trans < header.noTransitions; ++trans) {
+    records[2 * trans] = states.getTarget(trans);
+    records[2 * trans + 1] = states.getLabelId(trans);
+  }
+
+  // the propositions, as bitsets of the origins
+  std::vector<unsigned int> nameLengths;
+  std::string names;
+  const unsigned int noWords = (header.noOrigins + 31) / 32;
+  std::vector<unsigned int> bitsets(propositions.size() * noWords, 0);
+  for (unsigned int proposition = 0; proposition < propositions.size();
+      ++proposition) {
+    nameLengths.push_back(propositions.getName(proposition).size());
+    names.append(propositions.getName(proposition));
+    for (unsigned int origin = 0; origin < header.noOrigins; ++origin)
+      if (propositions.holds(proposition, origin))
+        bitsets[proposition * noWords + origin / 32] |= 1u << (origin % 32);
+  }
+
+  // open file
+  std::ofstream snapshotFile;
+  snapshotFile.open(filename.c_str(),
+      std::ios::out | std::ios::trunc | std::ios::binary);
+
+  if (!snapshotFile) {
+    graph->warn("Error opening file!");
+    return;
+  }
+
+  writePadded(snapshotFile, &header, sizeof(header));
+  writePadded(snapshotFile, graph->getComment().data(), header.commentLength);
+  writePadded(snapshotFile, labelRecords.empty() ? NULL : &labelRecords[0],
+      labelRecords.size() * sizeof(unsigned int));
+  writePadded(snapshotFile, texts.data(), texts.size());
+  writePadded(snapshotFile, &offsets[0], offsets.size() * sizeof(unsigned int));
+  writePadded(snapshotFile, numbers.empty() ? NULL : &numbers[0],
+      numbers.size() * sizeof(unsigned int));
+  writePadded(snapshotFile, origins.empty() ? NULL : &origins[0],
+      origins.size() * sizeof(unsigned int));
+  writePadded(snapshotFile, types.empty() ? NULL : &types[0], types.size());
+  writePadded(snapshotFile, marks.empty() ? NULL : &marks[0], marks.size());
+  writePadded(snapshotFile, records.empty() ? NULL : &records[0],
+      records.size() * sizeof(unsigned int));
+  writePadded(snapshotFile, nameLengths.empty() ? NULL : &nameLengths[0],
+      nameLengths.size() * sizeof(unsigned int));
+  writePadded(snapshotFile, names.data(), names.size());
+  writePadded(snapshotFile, bitsets.empty() ? NULL : &bitsets[0],
+      bitsets.size() * sizeof(unsigned int));
+
+  if (!snapshotFile)
+    graph->warn("Warning: It seems as if there was an error while writing "
+        "snapshot file.");
+  snapshotFile.close();
+}
+
+void GraphOutputSnapshot::writePadded(std::ofstream &file, const void* data,
+    const std::string::size_type &size)
+{
+  static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  if (size > 0)
+    file.write(static_cast<const char*>(data), size);
+  if (size % 8 != 0)
+    file.write(zeros, 8 - size % 8);
+}
+
+GraphOutputSnapshot::~GraphOutputSnapshot()
+{
+  // nothing to do
+}
+
+GraphOutputSnapshot::registerClass GraphOutputSnapshot::registerObject;
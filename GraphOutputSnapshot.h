@@ -0,0 +1,47 @@
+#ifndef __GRAPHOUTPUTSNAPSHOT_H
+#define __GRAPHOUTPUTSNAPSHOT_H
+
+#include <string>
+#include <fstream>
+#include "GraphOutput.h"
+#include "Graph.h"
+
+/** \brief Suitable for writing binary snapshots of a Graph.
+ *
+ * The snapshot contains all States (with their types, marks, numbers and
+ * origins), Transitions, Labels and propositions of the Graph, and its
+ * initial State and comment (see GraphSnapshotHeader for the format). It
+ * can be read again by GraphInputSnapshot much faster than any text format.
+ *
+ * Unlike the other GraphOutput classes, this one doesn't prepare the Graph
+ * for export (see Graph::prepareForExport()), so it may also write the IMC
+ * before the transformation (see option "--snapshot"), without changing it.
+ *
+ * This class handles the "imcsnap" format.
+ */
+class GraphOutputSnapshot : public GraphOutput {
+  public:
+    /// See GraphOutput::writeToFile
+    void writeToFile(Graph* graph, const std::string &format,
+        const std::string &filename);
+
+    /// Destructor
+    ~GraphOutputSnapshot();
+
+  private:
+
+    struct registerClass {
+      registerClass() {
+        Graph::registerOutput("imcsnap", new GraphOutputSnapshot);
+      }
+    };
+
+    static registerClass registerObject;
+
+    // writes `size` bytes, followed by zero bytes up to a multiple of 8
+    static void writePadded(std::ofstream &file, const void* data,
+        const std::string::size_type &size);
+
+};
+
+#endif
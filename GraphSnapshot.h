@@ -0,0 +1,57 @@
+#ifndef __GRAPHSNAPSHOT_H
+#define __GRAPHSNAPSHOT_H
+
+/** \brief The header of the binary snapshot format ("imcsnap").
+ *
+ * A snapshot stores a Graph as it is in memory, so it can be reloaded
+ * without parsing (see GraphInputSnapshot and GraphOutputSnapshot). All
+ * numbers are 32 bit unsigned integers in the byte order of the writing
+ * machine, the byteOrder field tells if it is the one of the reading
+ * machine. The header is followed by these sections, each one padded with
+ * zero bytes to a multiple of 8 bytes (so the arrays can be used directly
+ * from the mapped file):
+ *
+ * - the comment (commentLength bytes, see Graph::getComment())
+ * - the Labels, by their ids: two numbers for each one, ~0u and the length
+ *   of its text for a Label created from a text, or the ids of its head and
+ *   tail for a LabelPath (they are lower than its own id)
+ * - the texts of the Labels, one after the other (textLength bytes)
+ * - the States, by their index: the offsets of their Transitions
+ *   (noStates + 1 numbers, as in GraphCSR), their numbers, their origins
+ *   (see State::getOrigin()), then their types and their marks (one byte
+ *   each)
+ * - the Transitions: the index of their target State and the id of their
+ *   Label
+ * - the propositions (see PropositionTable): the lengths of their names,
+ *   the names one after the other, and for each proposition a bitset of
+ *   noOrigins bits, in (noOrigins + 31) / 32 numbers
+ *
+ * GraphInputSnapshot rejects a file that doesn't describe an IMC as it is
+ * after reading: the type of each State has to match the Labels of its
+ * Transitions, the numbers of the States have to be distinct and at most
+ * noStates, and each origin has to be lower than noOrigins (or ~0u).
+ */
+struct GraphSnapshotHeader {
+  /// Always "IMCSNAP" and a '\\0'
+  char magic[8];
+
+  /// The version of the format, see currentVersion
+  unsigned int version;
+
+  /// Always 0x01020304
+  unsigned int byteOrder;
+
+  /// Sizes of the sections
+  unsigned int noStates, noTransitions, noLabels, noPropositions, noOrigins;
+
+  /// The index of the initial State
+  unsigned int initialState;
+
+  /// More sizes of the sections, in bytes
+  unsigned int commentLength, textLength;
+
+  /// The actual version, it is increased whenever the format changes
+  static const unsigned int currentVersion = 1;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "GraphStatistics.h"
+#include <algorithm>
+#include "GraphCSR.h"
+
+GraphStatistics::GraphStatistics()
+{
+  clear();
+}
+
+void GraphStatistics::clear()
+{
+  std::fill(noStates, noStates + 4, 0);
+  std::fill(noTransitions, noTransitions + 4, 0);
+  std::fill(maxTransitions, maxTransitions + 4, 0);
+  noInteractiveTransitions = noMarkovTransitions = 0;
+  std::vector<double>().swap(exitRates);
+  minExitRate = maxExitRate = 0.0;
+  nondeterminismKnown = false;
+  internalNondeterminism = false;
+}
+
+void GraphStatistics::addState(const unsigned int &state,
+    const State::stateType &type, const unsigned int &noTrans)
+{
+  ++noStates[type];
+  noTransitions[type] += noTrans;
+  if (noTrans > maxTransitions[type])
+    maxTransitions[type] = noTrans;
+
+  if (type != State::MARKOV)
+    return;
+  const double exitRate = exitRates[state];
+  if (noStates[State::MARKOV] == 1)
+    minExitRate = maxExitRate = exitRate;
+  else if (exitRate < minExitRate)
+    minExitRate = exitRate;
+  else if (exitRate > maxExitRate)
+    maxExitRate = exitRate;
+}
+
+void GraphStatistics::compute(const GraphCSR &graph)
+{
+  clear();
+  exitRates.assign(graph.getStateNumber(), 0.0);
+  nondeterminismKnown = true;
+
+  // seenLabels[l] == state + 1 iff Label l has been seen on `state`
+  std::vector<unsigned int> seenLabels(graph.getLabelNumber(), 0);
+
+  for (unsigned int state = 0; state < graph.getStateNumber(); ++state) {
+    const State::stateType type = graph.getType(state);
+    double &exitRate = exitRates[state];
+
+    for (unsigned int trans = graph.getTransitionsBegin(state);
+        trans != graph.getTransitionsEnd(state); ++trans) {
+      if (graph.isInteractive(trans))
+        ++noInteractiveTransitions;
+      else {
+        ++noMarkovTransitions;
+        exitRate += graph.getRate(trans);
+      }
+
+      // two Transitions of a non-markov State with the same Label?
+      if ((type != State::MARKOV) && !internalNondeterminism) {
+        unsigned int &seen = seenLabels[graph.getLabelId(trans)];
+        internalNondeterminism = (seen == state + 1);
+        seen = state + 1;
+      }
+    }
+
+    addState(state, type, graph.getTransitionsEnd(state)
+        - graph.getTransitionsBegin(state));
+  }
+}
+
+void GraphStatistics::assignNumbers(const GraphStatistics &other)
+{
+  std::copy(other.noStates, other.noStates + 4, noStates);
+  std::copy(other.noTransitions, other.noTransitions + 4, noTransitions);
+  std::copy(other.maxTransitions, other.maxTransitions + 4, maxTransitions);
+  noInteractiveTransitions = other.noInteractiveTransitions;
+  noMarkovTransitions = other.noMarkovTransitions;
+  std::vector<double>().swap(exitRates);
+  minExitRate = other.minExitRate;
+  maxExitRate = other.maxExitRate;
+  nondeterminismKnown = other.nondeterminismKnown;
+  internalNondeterminism = other.internalNondeterminism;
+}
+
+void GraphStatistics::swap(GraphStatistics &other)
+{
+  for (unsigned int type = 0; type < 4; ++type) {
+    std::swap(noStates[type], other.noStates[type]);
+    std::swap(noTransitions[type], other.noTransitions[type]);
+    std::swap(maxTransitions[type], other.maxTransitions[type]);
+  }
+  std::swap(noInteractiveTransitions, other.noInteractiveTransitions);
+  std::swap(noMarkovTransitions, other.noMarkovTransitions);
+  exitRates.swap(other.exitRates);
+  std::swap(minExitRate, other.minExitRate);
+  std::swap(maxExitRate, other.maxExitRate);
+  std::swap(nondeterminismKnown, other.nondeterminismKnown);
+  std::swap(internalNondeterminism, other.internalNondeterminism);
+}
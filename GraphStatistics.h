@@ -0,0 +1,72 @@
+#ifndef __GRAPHSTATISTICS_H
+#define __GRAPHSTATISTICS_H
+
+#include <vector>
+#include "State.h"
+
+// forward-declarations
+class GraphCSR;
+
+/** \brief Numbers of States and Transitions of a Graph, and the exit rates of
+ *         its States.
+ *
+ * The readers collect the statistics while loading the Graph (see
+ * GraphBuilder::finish()), otherwise they are computed by one pass over the
+ * GraphCSR (see compute()). The Graph caches them until it is modified (see
+ * Graph::getStatistics()), so checking the uniformity, uniformizing and the
+ * statistics of the transformation need no more passes of their own.
+ */
+struct GraphStatistics {
+  /// Number of States of each type (indexed by State::stateType)
+  unsigned int noStates[4];
+
+  /// Number of Transitions emanating the States of each type
+  unsigned int noTransitions[4];
+
+  /// Maximal number of Transitions emanating a State of each type
+  unsigned int maxTransitions[4];
+
+  /// Number of interactive and of markov Transitions
+  unsigned int noInteractiveTransitions, noMarkovTransitions;
+
+  /** \brief The exit rate of each State
+   *
+   * The sum of the rates of its markov Transitions, indexed by the position
+   * of the State in the vector of States (see Graph::getStates()).
+   */
+  std::vector<double> exitRates;
+
+  /// Minimal and maximal exit rate of a markov State (0.0 without any)
+  double minExitRate, maxExitRate;
+
+  /** \brief Is nondeterminism known? (see internalNondeterminism)
+   *
+   * It is not known, if the statistics have been collected while loading.
+   */
+  bool nondeterminismKnown;
+
+  /// see Graph::hasInternalNondeterminism()
+  bool internalNondeterminism;
+
+  /// Constructor, the statistics of an empty Graph
+  GraphStatistics();
+
+  /// Start with the statistics of an empty Graph again
+  void clear();
+
+  /// Count the given State, after its exit rate is known (see exitRates)
+  void addState(const unsigned int &state, const State::stateType &type,
+      const unsigned int &noTrans);
+
+  /// Compute all statistics by one pass over the given GraphCSR
+  void compute(const GraphCSR &graph);
+
+  /// Copy the given statistics, except the exit rates
+  void assignNumbers(const GraphStatistics &other);
+
+  /// Exchange the statistics with the given ones
+  void swap(GraphStatistics &other);
+
+};
+
+#endif
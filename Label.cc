@@ -32,6 +32,7 @@ Label* Label::create(const std::string &text)
 }
 
 Label::Label()
+  : id(0)
 {
   // nothing to do
 }
@@ -41,12 +42,12 @@ Label::~Label()
   // nothing to do
 }
 
-Label* Label::prepend(Label* label) {
-  return prepend(label->str());
+Label* Label::prepend(Graph &graph, Label* label) {
+  return graph.getPathLabelPtr(label, this);
 }
 
-Label* Label::prepend(const std::string &newText) {
-  return Graph::getLabelPtr(newText + separator + str());
+Label* Label::prepend(Graph &graph, const std::string &newText) {
+  return prepend(graph, graph.getLabelPtr(newText));
 }
 
 LabelI::LabelI(const std::string &iText)
@@ -168,3 +169,45 @@ double LabelM::getRate() const
 {
   return rate;
 }
+
+LabelPath::LabelPath(Label *const &myHead, Label *const &myTail)
+  : Label(), head(myHead), tail(myTail)
+{
+}
+
+LabelPath::~LabelPath()
+{
+  // nothing to do, head and tail are destroyed by the LabelTable
+}
+
+bool LabelPath::isInteractive() const
+{
+  return true;
+}
+
+bool LabelPath::isTau() const
+{
+  return false;
+}
+
+std::string LabelPath::str()
+{
+  // walk along the tails without recursion, the paths may be long
+  std::string text(head->str());
+  Label* rest = tail;
+  for (LabelPath* path = dynamic_cast<LabelPath*>(rest); path != NULL;
+      path = dynamic_cast<LabelPath*>(rest)) {
+    text.append(separator);
+    text.append(path->head->str());
+    rest = path->tail;
+  }
+  text.append(separator);
+  text.append(rest->str());
+  return text;
+}
+
+double LabelPath::getRate() const
+{
+  assert(false);
+  return 0.0;
+}
@@ -3,6 +3,9 @@
 
 #include <string>
 
+// forward-declaration
+class Graph;
+
 /** \brief Abstract base class for LabelI and LabelM
  *
  * Represents a label that can be associated with a Transition.
@@ -53,21 +56,37 @@ class Label {
     
     /** \brief Prepend the Label with some other Label.
      * 
-     * The same as prepend(label->str()). The Label instance will be
-     * unchanged, a new Label is created and returned.
+     * The Label instance will be unchanged, a LabelPath consisting of the
+     * given Label and this Label is returned (see Graph::getPathLabelPtr()).
+     * Its text is label->str() + #separator + str().
      */
-    Label* prepend(Label* label);
+    Label* prepend(Graph &graph, Label* label);
     
     /** \brief Prepend the Label with some text.
      * 
-     * The Label instance will be unchanged, a new (interactive) Label
-     * is created and returned.
+     * The same as prepend(graph, graph.getLabelPtr(newText)).
      * 
+     * @param graph   The Graph that stores the new Label (see
+     *                Graph::getLabelPtr())
      * @param newText The text of the new Label will be this text +
      *                #separator + the text of the actual Label
      *                (return value of str()).
      */
-    Label* prepend(const std::string &newText);
+    Label* prepend(Graph &graph, const std::string &newText);
+
+    /** \brief Returns the id of the Label.
+     *
+     * The Labels of a Graph are numbered densely, from 0 up to the number of
+     * Labels - 1 (see LabelTable).
+     */
+    unsigned int getId() const {
+      return id;
+    }
+
+    /// Sets the id of the Label, is called by the LabelTable
+    void setId(const unsigned int &newId) {
+      id = newId;
+    }
 
     /// Destruktor
     virtual ~Label();
@@ -83,6 +102,11 @@ class Label {
      */
     static const std::string separator;
 
+  private:
+
+    // the id of the Label in its LabelTable
+    unsigned int id;
+
 };
 
 /// An interactive Label.
@@ -172,5 +196,59 @@ class LabelM: public Label {
 
 };
 
+/** \brief An interactive Label for a path of interactive Transitions.
+ *
+ * The closure of an interactive State (see State::getMarkovSuccs()) labels
+ * the Transition to a markov successor by the Labels of all interactive
+ * Transitions on the path to it. Such a path is stored as a LabelPath
+ * consisting of the Label of the first Transition (the head) and the Label
+ * of the rest of the path (the tail, which may again be a LabelPath).
+ * The LabelPaths are hash-consed by the LabelTable, so paths with a common
+ * tail share it, and the text of a path is only built when str() is called.
+ */
+class LabelPath: public Label {
+
+  public:
+
+    /// Constructor
+    LabelPath(Label *const &head, Label *const &tail);
+
+    /// Destructor
+    virtual ~LabelPath();
+
+    /// Always true
+    virtual bool isInteractive() const;
+
+    /// Always false
+    virtual bool isTau() const;
+
+    /** \brief Returns the text of the path.
+     *
+     * The texts of all Labels on the path, separated by #separator. The text
+     * is not stored, but built on each call.
+     */
+    virtual std::string str();
+
+    /// Returns always 0.0
+    virtual double getRate() const;
+
+    /// Returns the Label of the first Transition of the path
+    Label* getHead() const {
+      return head;
+    }
+
+    /// Returns the Label of the rest of the path
+    Label* getTail() const {
+      return tail;
+    }
+
+  private:
+
+    Label* head;
+
+    Label* tail;
+
+};
+
 #endif
 
@@ -0,0 +1,155 @@
+#include "LabelTable.h"
+#include <cstring>
+#include <cassert>
+
+const unsigned int LabelTable::empty = ~0u;
+const unsigned int LabelTable::interactiveTag;
+const unsigned int LabelTable::tauTag;
+const unsigned int LabelTable::indexMask;
+
+LabelTable::LabelTable()
+  : buckets(64, empty), pathBuckets(64, empty), noPaths(0)
+{
+  textOffsets.push_back(0);
+}
+
+LabelTable::~LabelTable()
+{
+  for (std::vector<Label*>::const_iterator it = labels.begin();
+      it != labels.end(); ++it)
+    delete *it;
+  labels.clear();
+}
+
+Label* LabelTable::intern(const std::string &text)
+{
+  const unsigned int textHash = hash(text.data(), text.size());
+  const unsigned int mask = buckets.size() - 1;
+
+  // linear probing
+  unsigned int bucket = textHash & mask;
+  for (; buckets[bucket] != empty; bucket = (bucket + 1) & mask) {
+    const unsigned int id = buckets[bucket];
+    if ((hashes[id] == textHash)
+        && (textOffsets[id + 1] - textOffsets[id] == text.size())
+        && (text.empty() || (memcmp(&texts[textOffsets[id]], text.data(),
+              text.size()) == 0)))
+      return labels[id];
+  }
+
+  // not found, so create a new Label (may throw, so the table is changed
+  // afterwards)
+  Label* label = Label::create(text);
+  buckets[bucket] = labels.size();
+  add(label, textHash, text);
+
+  // keep the load factor below 1/2
+  if (2 * (labels.size() - noPaths) > buckets.size())
+    grow(buckets);
+
+  return label;
+}
+
+Label* LabelTable::internPath(Label *const &head, Label *const &tail)
+{
+  const unsigned int pathHash = hash(head->getId(), tail->getId());
+  unsigned int bucket;
+  if (Label* found = findPath(head, tail, pathHash, bucket))
+    return found;
+
+  Label* label = new LabelPath(head, tail);
+  pathBuckets[bucket] = labels.size();
+  add(label, pathHash, std::string());
+  ++noPaths;
+
+  if (2 * noPaths > pathBuckets.size())
+    grow(pathBuckets);
+
+  return label;
+}
+
+Label* LabelTable::findPath(Label *const &head, Label *const &tail) const
+{
+  unsigned int bucket;
+  return findPath(head, tail, hash(head->getId(), tail->getId()), bucket);
+}
+
+Label* LabelTable::findPath(Label *const &head, Label *const &tail,
+    const unsigned int &pathHash, unsigned int &bucket) const
+{
+  const unsigned int mask = pathBuckets.size() - 1;
+
+  // linear probing
+  for (bucket = pathHash & mask; pathBuckets[bucket] != empty;
+      bucket = (bucket + 1) & mask) {
+    const unsigned int id = pathBuckets[bucket];
+    // only LabelPaths are in pathBuckets
+    const LabelPath* path = static_cast<const LabelPath*>(labels[id]);
+    if ((path->getHead() == head) && (path->getTail() == tail))
+      return labels[id];
+  }
+  return NULL;
+}
+
+std::string LabelTable::getText(const unsigned int &id) const
+{
+  if (dynamic_cast<LabelPath*>(labels[id]) != NULL)
+    return labels[id]->str();
+  return std::string(texts.begin() + textOffsets[id],
+      texts.begin() + textOffsets[id + 1]);
+}
+
+void LabelTable::add(Label *const &label, const unsigned int &labelHash,
+    const std::string &text)
+{
+  label->setId(labels.size());
+  labels.push_back(label);
+  // the ids and the rate indices must fit into the tags
+  assert(labels.size() <= indexMask + 1);
+  if (label->isInteractive())
+    tags.push_back(interactiveTag | (label->isTau() ? tauTag : 0)
+        | label->getId());
+  else {
+    tags.push_back(rates.size());
+    rates.push_back(label->getRate());
+    rateLabels.push_back(label->getId());
+  }
+  texts.insert(texts.end(), text.begin(), text.end());
+  textOffsets.push_back(texts.size());
+  hashes.push_back(labelHash);
+}
+
+unsigned int LabelTable::hash(const char* text,
+    const std::string::size_type &length)
+{
+  unsigned int h = 2166136261u;
+  for (std::string::size_type i = 0; i < length; ++i) {
+    h ^= static_cast<unsigned char>(text[i]);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+unsigned int LabelTable::hash(const unsigned int &head,
+    const unsigned int &tail)
+{
+  unsigned int h = head * 2654435761u;
+  h ^= tail + 0x9e3779b9u + (h << 6) + (h >> 2);
+  return h * 2246822519u;
+}
+
+void LabelTable::grow(std::vector<unsigned int> &table)
+{
+  std::vector<unsigned int> newTable(2 * table.size(), empty);
+  const unsigned int mask = newTable.size() - 1;
+  for (std::vector<unsigned int>::const_iterator id = table.begin();
+      id != table.end(); ++id) {
+    if (*id == empty)
+      continue;
+    unsigned int bucket = hashes[*id] & mask;
+    while (newTable[bucket] != empty)
+      bucket = (bucket + 1) & mask;
+    newTable[bucket] = *id;
+  }
+  table.swap(newTable);
+}
@@ -0,0 +1,169 @@
+#ifndef __LABELTABLE_H
+#define __LABELTABLE_H
+
+#include <vector>
+#include <string>
+#include "Label.h"
+
+/** \brief Interner for the Labels of a Graph.
+ *
+ * Each Graph owns a LabelTable that maps label strings to Label objects.
+ * Equal strings are mapped to the same Label, so Labels can be compared by
+ * their pointers or by their ids: the Labels are numbered densely in the
+ * order of their creation (see Label::getId()), from 0 to size() - 1.
+ *
+ * The strings of all Labels are stored one after the other in one
+ * contiguous array, and they are found by an open-addressing hash table of
+ * Label ids, so a lookup costs one hash computation and (usually) one
+ * string comparison.
+ *
+ * The LabelPaths are hash-consed in a second hash table, keyed by the ids of
+ * their head and tail, so each path is stored once and has one id.
+ *
+ * For each Label, a 32 bit tag is stored (see getTag()): its kind in the
+ * upper two bits, and in the others its id (interactive Labels) or the
+ * index of its rate in a table of all rates (markov Labels). So the kind
+ * and the rate of a Label are known without a virtual call.
+ */
+class LabelTable {
+  public:
+    /// Constructor, creates an empty LabelTable
+    LabelTable();
+
+    /// Destructor, deletes all Labels
+    ~LabelTable();
+
+    /** \brief Return the Label for the given string.
+     *
+     * If there is no Label for this string yet, it is created by
+     * Label::create() and gets the next free id.
+     *
+     * @param text The (already quoted, see Label::quote()) label string
+     */
+    Label* intern(const std::string &text);
+
+    /** \brief Return the LabelPath for the given head and tail.
+     *
+     * If there is no such LabelPath yet, it is created and gets the next
+     * free id. Both Labels must be contained in this LabelTable.
+     */
+    Label* internPath(Label *const &head, Label *const &tail);
+
+    /** \brief Return the LabelPath for the given head and tail, if it exists.
+     *
+     * Unlike internPath(), this doesn't change the LabelTable, so it may be
+     * called concurrently (as long as nobody changes the LabelTable).
+     *
+     * @return The LabelPath, or NULL if there is none yet
+     */
+    Label* findPath(Label *const &head, Label *const &tail) const;
+
+    /// Returns the number of Labels
+    unsigned int size() const {
+      return labels.size();
+    }
+
+    /// Returns the Label with the given id
+    Label* get(const unsigned int &id) const {
+      return labels[id];
+    }
+
+    /// Set in the tags of the interactive Labels
+    static const unsigned int interactiveTag = 1u << 31;
+
+    /// Set in the tags of the interactive Labels with text "i"
+    static const unsigned int tauTag = 1u << 30;
+
+    /// Masks the id or the rate index in a tag
+    static const unsigned int indexMask = tauTag - 1;
+
+    /** \brief Returns the tag of the Label with the given id
+     *
+     * For an interactive Label, this is interactiveTag, combined with tauTag
+     * if it is a tau Label, and with its id. For a markov Label, this is the
+     * index of its rate (see getRate()).
+     */
+    unsigned int getTag(const unsigned int &id) const {
+      return tags[id];
+    }
+
+    /// Is the Label with the given id interactive?
+    bool isInteractive(const unsigned int &id) const {
+      return (tags[id] & interactiveTag) != 0;
+    }
+
+    /// Returns the rate with the given index (see getTag())
+    double getRate(const unsigned int &rateIndex) const {
+      return rates[rateIndex];
+    }
+
+    /// Returns the id of the markov Label with the given rate index
+    unsigned int getRateLabelId(const unsigned int &rateIndex) const {
+      return rateLabels[rateIndex];
+    }
+
+    /** \brief Returns the text of the Label with the given id
+     *
+     * This is the string the Label has been created from, or the text of the
+     * path for a LabelPath (see LabelPath::str()).
+     */
+    std::string getText(const unsigned int &id) const;
+
+  private:
+    // not copyable
+    LabelTable(const LabelTable&);
+    LabelTable& operator=(const LabelTable&);
+
+    // hash value of a string (FNV-1a)
+    static unsigned int hash(const char* text, const std::string::size_type
+        &length);
+
+    // hash value of a path
+    static unsigned int hash(const unsigned int &head,
+        const unsigned int &tail);
+
+    // looks up the path with the given hash value, `bucket` is set to the
+    // bucket where it has been found, or to the empty bucket where it
+    // belongs
+    Label* findPath(Label *const &head, Label *const &tail,
+        const unsigned int &pathHash, unsigned int &bucket) const;
+
+    // adds a new Label with the given hash value and text
+    void add(Label *const &label, const unsigned int &labelHash,
+        const std::string &text);
+
+    // doubles the number of buckets of the given table and inserts all ids
+    // again
+    void grow(std::vector<unsigned int> &table);
+
+    // marks an empty bucket
+    static const unsigned int empty;
+
+    // the Labels by their id, and their tags
+    std::vector<Label*> labels;
+    std::vector<unsigned int> tags;
+
+    // the rates of the markov Labels by their rate index, and their ids
+    std::vector<double> rates;
+    std::vector<unsigned int> rateLabels;
+
+    // the strings of all Labels one after the other, the string of Label
+    // `id` starts at textOffsets[id] and ends at textOffsets[id + 1]
+    // (empty for the LabelPaths)
+    std::vector<char> texts;
+    std::vector<std::string::size_type> textOffsets;
+
+    // the hash value of the string (or the path) of each Label
+    std::vector<unsigned int> hashes;
+
+    // the hash tables for the strings and for the paths, they contain Label
+    // ids (or `empty`), the number of buckets is a power of two
+    std::vector<unsigned int> buckets;
+    std::vector<unsigned int> pathBuckets;
+
+    // number of LabelPaths
+    unsigned int noPaths;
+
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifndef MMAP_IS_ABSENT
+  #include <sys/mman.h>
+#endif
+#ifndef O_BINARY
+  #define O_BINARY 0
+#endif
+
+MappedFile::MappedFile()
+  : data(NULL), length(0), mapped(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+bool MappedFile::open(const std::string &filename)
+{
+  close();
+
+  const int fd = ::open(filename.c_str(), O_RDONLY | O_BINARY);
+  if (fd < 0)
+    return false;
+
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+#ifndef MMAP_IS_ABSENT
+  // an empty file can't be mapped, and anything but regular files is read
+  if (S_ISREG(status.st_mode) && (status.st_size > 0)) {
+    void* address = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED) {
+      // the files are parsed from the beginning to the end
+      madvise(address, status.st_size, MADV_SEQUENTIAL);
+      ::close(fd);
+      data = static_cast<const char*>(address);
+      length = status.st_size;
+      mapped = true;
+      return true;
+    }
+  }
+#endif
+
+  const bool ok = readBuffer(fd);
+  ::close(fd);
+  return ok;
+}
+
+void MappedFile::close()
+{
+#ifndef MMAP_IS_ABSENT
+  if (mapped)
+    munmap(const_cast<char*>(data), length);
+#endif
+  std::vector<char>().swap(buffer);
+  data = NULL;
+  length = 0;
+  mapped = false;
+}
+
+bool MappedFile::readBuffer(const int &fd)
+{
+  char block[65536];
+  ssize_t got;
+  while ((got = ::read(fd, block, sizeof(block))) > 0)
+    buffer.insert(buffer.end(), block, block + got);
+  if (got < 0) {
+    std::vector<char>().swap(buffer);
+    return false;
+  }
+  data = buffer.empty() ? NULL : &buffer[0];
+  length = buffer.size();
+  return true;
+}
@@ -0,0 +1,70 @@
+#ifndef __MAPPEDFILE_H
+#define __MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+
+/** \brief The contents of a file in memory, for reading it.
+ *
+ * The file is mapped into memory (mmap), so the GraphInput classes can parse
+ * it directly from the mapped bytes without copying them into strings or
+ * streams first. If MMAP_IS_ABSENT is defined (or mapping the file fails),
+ * the file is read into a buffer instead.
+ *
+ * The contents are not terminated by a '\\0' character.
+ */
+class MappedFile {
+  public:
+    /// Constructor, nothing is opened yet
+    MappedFile();
+
+    /// Destructor, closes the file (see close())
+    ~MappedFile();
+
+    /** \brief Open the file with the given name.
+     *
+     * An open file is closed before.
+     *
+     * @return false, if the file could not be opened or read
+     */
+    bool open(const std::string &filename);
+
+    /// Unmap the file (or free the buffer)
+    void close();
+
+    /// The first byte of the contents
+    const char* begin() const {
+      return data;
+    }
+
+    /// Behind the last byte of the contents
+    const char* end() const {
+      return data + length;
+    }
+
+    /// The number of bytes
+    std::string::size_type size() const {
+      return length;
+    }
+
+  private:
+    // not copyable
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    // reads the file descriptor into `buffer`
+    bool readBuffer(const int &fd);
+
+    // the contents, and their length
+    const char* data;
+    std::string::size_type length;
+
+    // set, if `data` is mapped (otherwise it points into `buffer`)
+    bool mapped;
+
+    // the contents, if the file is not mapped
+    std::vector<char> buffer;
+
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "PropositionTable.h"
+
+PropositionTable::PropositionTable()
+{
+}
+
+PropositionTable::~PropositionTable()
+{
+  // nothing to do
+}
+
+unsigned int PropositionTable::add(const std::string &name)
+{
+  unsigned int proposition;
+  if (find(name, proposition))
+    return proposition;
+  names.push_back(name);
+  bitsets.push_back(std::vector<bool>());
+  return names.size() - 1;
+}
+
+bool PropositionTable::find(const std::string &name,
+    unsigned int &proposition) const
+{
+  // there are only few propositions, so a linear search is fast enough
+  for (std::vector<std::string>::size_type i = 0; i < names.size(); ++i)
+    if (names[i] == name) {
+      proposition = i;
+      return true;
+    }
+  return false;
+}
+
+void PropositionTable::set(const unsigned int &proposition,
+    const unsigned int &origin)
+{
+  std::vector<bool> &states = bitsets[proposition];
+  if (origin >= states.size())
+    states.resize(origin + 1, false);
+  states[origin] = true;
+}
+
+void PropositionTable::clear()
+{
+  names.clear();
+  bitsets.clear();
+}
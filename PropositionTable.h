@@ -0,0 +1,73 @@
+#ifndef __PROPOSITIONTABLE_H
+#define __PROPOSITIONTABLE_H
+
+#include <vector>
+#include <string>
+
+/** \brief The atomic propositions (state labels) of the input file.
+ *
+ * Each Graph owns a PropositionTable. The propositions are numbered densely
+ * in the order of their creation, from 0 to size() - 1. For each
+ * proposition, a bitset tells which States it holds in. The States are
+ * referred to by their origin (see State::getOrigin()), i.e. by their number
+ * in the input file, so the bitsets needn't be updated when States are
+ * created, deleted or renumbered.
+ *
+ * The propositions are read by GraphInputPrism (from the ".labels" file)
+ * and written by GraphOutputLab (see Graph::setLabPropositions()).
+ */
+class PropositionTable {
+  public:
+    /// Constructor, creates an empty PropositionTable
+    PropositionTable();
+
+    /// Destructor
+    ~PropositionTable();
+
+    /** \brief Return the number of the proposition with the given name.
+     *
+     * If there is no such proposition yet, it is created (holding in no
+     * State) and gets the next free number.
+     */
+    unsigned int add(const std::string &name);
+
+    /** \brief Search the proposition with the given name.
+     *
+     * @return false, if there is no such proposition
+     */
+    bool find(const std::string &name, unsigned int &proposition) const;
+
+    /// Returns the number of propositions
+    unsigned int size() const {
+      return names.size();
+    }
+
+    /// Returns the name of the given proposition
+    const std::string& getName(const unsigned int &proposition) const {
+      return names[proposition];
+    }
+
+    /// Let the given proposition hold in the State with the given origin
+    void set(const unsigned int &proposition, const unsigned int &origin);
+
+    /// Does the given proposition hold in the State with the given origin?
+    bool holds(const unsigned int &proposition, const unsigned int &origin)
+      const {
+      const std::vector<bool> &states = bitsets[proposition];
+      return (origin < states.size()) && states[origin];
+    }
+
+    /// Delete all propositions
+    void clear();
+
+  private:
+    // the names of the propositions, by their numbers
+    std::vector<std::string> names;
+
+    // for each proposition, the origins of the States where it holds (the
+    // bitsets only grow up to the largest origin that is set)
+    std::vector< std::vector<bool> > bitsets;
+
+};
+
+#endif
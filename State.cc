@@ -2,25 +2,23 @@
 #include <cassert>
 #include "Transition.h"
 #include "Graph.h"
+#include "ClosureContext.h"
 
 // State construktor
 State::State()
-  : markovSuccFinished(false), type(NOTDEC), mark(false), interactivePred(NULL)
+  : markovSuccFinished(false), type(NOTDEC), number(0), origin(~0u),
+    index(0), mark(false), interactivePred(NULL)
 {
 }
 
 // State destructor
 State::~State()
 {
-  // delete all Transitions emanating this state
-  for (std::vector<Transition*>::const_iterator it =
-      transitions.begin(); it != transitions.end(); ++it)
-    delete *it;
-  // clear the vectors
-  transitions.clear();
+  // nothing to do, the Transitions are destroyed by the Graph (see
+  // Graph::deleteState)
 }
 
-void State::getMarkovSuccs(const bool &computeLabels)
+void State::getMarkovSuccs(ClosureContext &context)
 {
   // this method should only be called for INTERACTIVE states !!
   assert((getType() == INTERACTIVE) || (getType() == HYBRID));
@@ -31,15 +29,17 @@ void State::getMarkovSuccs(const bool &computeLabels)
   markovSuccFinished = true;
 
   // now all INTERACTIVE transitions are cut off, and transitions to MARKOV
-  // states are searched
+  // states are searched; several paths may lead to the same MARKOV state
+  // with the same label, such a transition is only kept once
   std::vector<Transition*> newTransitions;
+  context.clearSuccessors();
 
   for (std::vector<Transition*>::const_iterator trans = transitions.begin();
       trans != transitions.end(); ++trans) {
 
     if (!((*trans)->isInteractive())) {
       // a MARKOV transition emanating HYBRID state is cut off
-      delete *trans;
+      context.deleteTransition(*trans);
       continue;
     }
 
@@ -48,9 +48,12 @@ void State::getMarkovSuccs(const bool &computeLabels)
     // if MARKOV successor or sink state, keep the transition
     if ((successor->getType() == MARKOV) || 
         (successor->getType() == NOTDEC)) {
-      if (!computeLabels)
-        (*trans)->setLabel("DFS");
-      newTransitions.push_back(*trans);
+      if (!context.getComputeLabels())
+        (*trans)->setLabel(context.getDfsLabel());
+      if (context.addSuccessor(successor, (*trans)->getLabel()))
+        newTransitions.push_back(*trans);
+      else
+        context.deleteTransition(*trans);
     } else {
       // append all MARKOV succs of successor to state and prepend the
       // transition label to the "word" to the MARKOV succ
@@ -62,29 +65,34 @@ void State::getMarkovSuccs(const bool &computeLabels)
       if (successor == this)
         continue;
 
-      // first compute MARKOV successors for the state
-      successor->getMarkovSuccs(computeLabels);
+      // the MARKOV successors of the successor have already been computed
+      // (unless there is an interactive cycle)
+      assert(successor->markovSuccFinished || !Graph::getCycleSearch());
 
       for (std::vector<Transition*>::const_iterator it =
           successor->getTransitions()->begin();
           it != successor->getTransitions()->end(); ++it) {
-        Transition* newTrans;
-        if (computeLabels) {
+        // the label of the new transition is the label of (*it), the one
+        // of (*trans) if (*it) is a tau transition, or the path of both
+        Label* head = (*it)->getLabel();
+        Label* tail = NULL;
+        if (context.getComputeLabels()) {
           if ((*it)->isTau())
-            newTrans = new Transition((*it)->getTargetState(), (*trans)->getLabel());
-          else {
-            newTrans = new Transition(**it);
-            if (!(*trans)->isTau())
-              newTrans->setLabel(newTrans->getLabel()->prepend((*trans)->getLabel()));
+            head = (*trans)->getLabel();
+          else if (!(*trans)->isTau()) {
+            head = (*trans)->getLabel();
+            tail = (*it)->getLabel();
           }
-        } else
-          newTrans = new Transition(**it);
-        newTransitions.push_back(newTrans);
+        }
+        Transition* newTrans = context.newSuccessor((*it)->getTargetState(),
+            head, tail);
+        if (newTrans != NULL)
+          newTransitions.push_back(newTrans);
       }
 
       // now the transition can be deleted, because it's from INTERACTIVE
       // state to INTERACTIVE state
-      delete *trans;
+      context.deleteTransition(*trans);
     }
   }
   // now swap vectors `transitions` and `newTransitions`
@@ -125,6 +133,11 @@ void State::addTransition(Transition *const &newTransition)
   transitions.push_back(newTransition);
 }
 
+void State::reserveTransitions(const unsigned int &number)
+{
+  transitions.reserve(number);
+}
+
 std::vector<Transition*>::iterator State::removeTransition(
     std::vector<Transition*>::iterator &remove)
 {
@@ -151,6 +164,26 @@ void State::setNumber(const unsigned int &newNumber)
   number = newNumber;
 }
 
+unsigned int State::getOrigin() const
+{
+  return origin;
+}
+
+void State::setOrigin(const unsigned int &newOrigin)
+{
+  origin = newOrigin;
+}
+
+unsigned int State::getIndex() const
+{
+  return index;
+}
+
+void State::setIndex(const unsigned int &newIndex)
+{
+  index = newIndex;
+}
+
 void State::setInteractivePred(State *const &newInteractivePred)
 {
   interactivePred = newInteractivePred;
@@ -4,8 +4,10 @@
 #include <vector>
 #include <string>
 
-// forward-declaration
+// forward-declarations
 class Transition;
+class Graph;
+class ClosureContext;
 
 /** \brief Represents a single State
  *
@@ -34,25 +36,40 @@ class State {
       HYBRID
     };
 
-    /// Standard constructor
+    /** \brief Standard constructor
+     *
+     * The States of a Graph should be created by Graph::newState().
+     */
     State();
 
-    /// Destructor
+    /** \brief Destructor
+     *
+     * The emanating Transitions are not deleted, they are owned by the Graph
+     * (see Graph::deleteState()).
+     */
     ~State();
 
 
     /** \brief Compute the markov successors of the State
      *
      * Calling this method only makes sense for an interactive State.
-     * The computation of markov successors is by a DFS.
      * The Markov successors of a State are all markov States, that are
      * directly reached via a transition, and additionally the markov
      * successors of each interactive State, that is directly reached.
      *
-     * @param computeLabels should the labels (i.e. the concatenated path to
-     *                      the markov successor) be saved?
+     * The markov successors of the directly reached interactive States are
+     * not computed by this method, they must have been computed before
+     * (i.e. the States have to be handled in a bottom-up order, see
+     * Graph::transformImcToCtmdp()). Their Transitions are copied.
+     *
+     * The markov successors of States whose interactive successors are
+     * disjoint may be computed concurrently.
+     *
+     * @param context creates the new Transitions and their Labels, and says
+     *                whether the labels (i.e. the concatenated path to the
+     *                markov successor) should be saved
      */
-    void getMarkovSuccs(const bool &computeLabels = true);
+    void getMarkovSuccs(ClosureContext &context);
     
     /// Calculates new stateType based on the label of a new transition
     void determineStateType(const Transition *const &newTransition);
@@ -60,6 +77,9 @@ class State {
     /// Adds a new transition emanating this State
     void addTransition(Transition *const &newTransition);
 
+    /// Make room for the given number of transitions emanating this State
+    void reserveTransitions(const unsigned int &number);
+
     /** \brief Removes a transition
      *
      * The given iterator MUST point to a Transition emanating the State (i.e.
@@ -97,6 +117,28 @@ class State {
     /// Sets the number of the State
     void setNumber(const unsigned int &newNumber);
 
+    /** \brief Return the origin of the State
+     *
+     * The origin is the number of the State in the input file (starting with
+     * 0), States created by the transformation get the origin of the State
+     * they lead to. It is set by the GraphInput classes and, unlike the
+     * number, never changed afterwards, so it refers to the propositions of
+     * the Graph (see PropositionTable).
+     */
+    unsigned int getOrigin() const;
+    /// Sets the origin of the State
+    void setOrigin(const unsigned int &newOrigin);
+
+    /** \brief Return the index of the State
+     *
+     * The index is the position of the State in the vector of States of the
+     * Graph. It is set when the GraphCSR of the Graph is built (see
+     * GraphCSR::build) and is invalid after the vector has been modified.
+     */
+    unsigned int getIndex() const;
+    /// Sets the index of the State
+    void setIndex(const unsigned int &newIndex);
+
     /** \brief Set the interactive predecessor for the State
      *
      * In each State, the direct interactive predecessor is stored, for not
@@ -133,6 +175,12 @@ class State {
     // the output number of this State
     unsigned int number;
 
+    // the number of this State in the input file, ~0u if unknown
+    unsigned int origin;
+
+    // the position of this State in the Graph's vector of States
+    unsigned int index;
+
     // can this State do 'theAction'?
     bool mark;
 
@@ -0,0 +1,434 @@
+#include "TextInput.h"
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifndef ZLIB_IS_ABSENT
+  #include <zlib.h>
+#endif
+#ifndef THREADS_ARE_ABSENT
+  #include <pthread.h>
+#endif
+#ifndef O_BINARY
+  #define O_BINARY 0
+#endif
+
+// reads a file that isn't mapped into a few buffers, and inflates it if it is
+// compressed: the reading thread fills the empty buffers, and nextBlock()
+// hands out the full ones
+struct TextInput::Reader {
+  // minimal size of a buffer, and number of buffers
+  static const std::string::size_type blockSize = 1 << 24;
+  static const unsigned int noBlocks = 3;
+
+  // the file (closed by the destructor, unless it is standard input), and
+  // the bytes read from it but not used yet
+  int fd;
+  bool closeFile;
+  std::vector<unsigned char> input;
+  std::string::size_type inputBegin, inputEnd;
+  // are the first bytes read, is the file compressed, is its end read, is
+  // the whole text read?
+  bool started, compressed, endOfFile, endOfStream;
+  bool error;
+#ifndef ZLIB_IS_ABSENT
+  z_stream stream;
+  // is a gzip member incomplete?
+  bool inMember;
+#endif
+
+  // the buffers, the number of their valid bytes, and the incomplete last
+  // line of the last buffer, which begins the next one
+  std::vector<char> blocks[noBlocks];
+  std::string::size_type lengths[noBlocks];
+  std::vector<char> rest;
+
+  // the numbers of the full and of the empty buffers, and the one handed out
+  // by nextBlock() (or -1)
+  std::deque<unsigned int> full, empty;
+  int current;
+
+#ifndef THREADS_ARE_ABSENT
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  // signalled whenever a buffer gets full or empty, or stop is set
+  pthread_cond_t changed;
+  // set by the destructor, and by the thread when it is done
+  bool stop, finished;
+#endif
+
+  Reader(const int &fd, const bool &closeFile)
+    : fd(fd), closeFile(closeFile), input(1 << 18), inputBegin(0),
+      inputEnd(0), started(false), compressed(false), endOfFile(false),
+      endOfStream(false), error(false), current(-1) {
+#ifndef ZLIB_IS_ABSENT
+    memset(&stream, 0, sizeof(stream));
+    inMember = false;
+#endif
+    for (unsigned int block = 0; block < noBlocks; ++block)
+      empty.push_back(block);
+#ifndef THREADS_ARE_ABSENT
+    stop = finished = false;
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&changed, NULL);
+    if (pthread_create(&thread, NULL, threadMain, this) != 0) {
+      error = finished = true;
+      thread = pthread_self();
+    }
+#endif
+  }
+
+  ~Reader() {
+#ifndef THREADS_ARE_ABSENT
+    pthread_mutex_lock(&mutex);
+    stop = true;
+    pthread_cond_broadcast(&changed);
+    pthread_mutex_unlock(&mutex);
+    if (!pthread_equal(thread, pthread_self()))
+      pthread_join(thread, NULL);
+    pthread_cond_destroy(&changed);
+    pthread_mutex_destroy(&mutex);
+#endif
+#ifndef ZLIB_IS_ABSENT
+    if (compressed)
+      inflateEnd(&stream);
+#endif
+    if (closeFile)
+      ::close(fd);
+  }
+
+  // has the destructor been called? (then the thread should end soon, even
+  // if the file is a pipe that is still written to)
+  bool stopped() {
+#ifdef THREADS_ARE_ABSENT
+    return false;
+#else
+    pthread_mutex_lock(&mutex);
+    const bool result = stop;
+    pthread_mutex_unlock(&mutex);
+    return result;
+#endif
+  }
+
+  // reads the next bytes into `input`, behind the unused ones
+  void readInput() {
+    if (inputBegin == inputEnd)
+      inputBegin = inputEnd = 0;
+    ssize_t got;
+    do
+      got = ::read(fd, &input[inputEnd], input.size() - inputEnd);
+    while ((got < 0) && (errno == EINTR));
+    if (got < 0)
+      error = true;
+    else if (got == 0)
+      endOfFile = true;
+    else
+      inputEnd += got;
+  }
+
+  // reads the first bytes, to see whether the file is compressed
+  void start() {
+    started = true;
+    while ((inputEnd < 2) && !endOfFile && !error)
+      readInput();
+    // a gzip file begins with the bytes 0x1f 0x8b
+    compressed = (inputEnd >= 2) && (input[0] == 0x1f) && (input[1] == 0x8b);
+    if (!compressed)
+      return;
+#ifdef ZLIB_IS_ABSENT
+    error = true;
+#else
+    // decode a gzip (or zlib) header
+    error = error || (inflateInit2(&stream, 15 + 32) != Z_OK);
+#endif
+  }
+
+  // appends the next bytes of an uncompressed file to the buffer
+  void append(std::vector<char> &block, std::string::size_type &length) {
+    while ((length < block.size()) && !endOfStream && !error && !stopped()) {
+      if (inputBegin != inputEnd) {
+        const std::string::size_type size = std::min(inputEnd - inputBegin,
+            block.size() - length);
+        memcpy(&block[length], &input[inputBegin], size);
+        inputBegin += size;
+        length += size;
+        continue;
+      }
+      ssize_t got;
+      do
+        got = ::read(fd, &block[length], block.size() - length);
+      while ((got < 0) && (errno == EINTR));
+      if (got < 0)
+        error = true;
+      else if (got == 0)
+        endOfStream = true;
+      else
+        length += got;
+    }
+  }
+
+#ifndef ZLIB_IS_ABSENT
+  // appends the next bytes of a compressed file to the buffer, inflated
+  void inflateAppend(std::vector<char> &block,
+      std::string::size_type &length) {
+    while ((length < block.size()) && !endOfStream && !error && !stopped()) {
+      if ((inputBegin == inputEnd) && !endOfFile) {
+        readInput();
+        continue;
+      }
+      if ((inputBegin == inputEnd) && !inMember) {
+        endOfStream = true;
+        break;
+      }
+
+      // (at the end of the file, this flushes the pending output)
+      stream.next_in = &input[inputBegin];
+      stream.avail_in = inputEnd - inputBegin;
+      stream.next_out = reinterpret_cast<Bytef*>(&block[length]);
+      stream.avail_out = block.size() - length;
+      const int result = inflate(&stream, Z_NO_FLUSH);
+      inputBegin = inputEnd - stream.avail_in;
+      length = block.size() - stream.avail_out;
+      if (result == Z_STREAM_END) {
+        // another gzip member may follow
+        inflateReset(&stream);
+        inMember = false;
+      } else if (result == Z_OK)
+        inMember = true;
+      else if (result == Z_BUF_ERROR)
+        // no progress: a truncated file is an error
+        error = (inputBegin == inputEnd) && endOfFile;
+      else
+        error = true;
+    }
+  }
+#endif
+
+  // fills the buffer with the next lines, returns false if there are none
+  // (or on an error)
+  bool fill(std::vector<char> &block, std::string::size_type &length) {
+    if (!started)
+      start();
+    if (block.size() < blockSize)
+      block.resize(blockSize);
+    if (block.size() < 2 * rest.size())
+      block.resize(2 * rest.size());
+    length = rest.size();
+    if (!rest.empty())
+      memcpy(&block[0], &rest[0], rest.size());
+    rest.clear();
+
+    while (!error && !stopped()) {
+#ifndef ZLIB_IS_ABSENT
+      if (compressed)
+        inflateAppend(block, length);
+      else
+#endif
+        append(block, length);
+
+      if (error)
+        return false;
+      if (endOfStream)
+        return length > 0;
+      if (length < block.size())
+        // stopped
+        return false;
+
+      // the buffer is full: keep the incomplete last line for the next one
+      std::string::size_type lineEnd = length;
+      while ((lineEnd > 0) && (block[lineEnd - 1] != '\n'))
+        --lineEnd;
+      if (lineEnd > 0) {
+        rest.assign(block.begin() + lineEnd, block.begin() + length);
+        length = lineEnd;
+        return true;
+      }
+      // a line longer than the buffer
+      block.resize(2 * block.size());
+    }
+    return false;
+  }
+
+#ifndef THREADS_ARE_ABSENT
+  static void* threadMain(void* reader) {
+    static_cast<Reader*>(reader)->run();
+    return NULL;
+  }
+
+  // the reading thread: fills the empty buffers until the file is read, or
+  // the Reader is destroyed
+  void run() {
+    pthread_mutex_lock(&mutex);
+    while (!stop) {
+      if (empty.empty()) {
+        pthread_cond_wait(&changed, &mutex);
+        continue;
+      }
+      const unsigned int block = empty.front();
+      empty.pop_front();
+      pthread_mutex_unlock(&mutex);
+
+      const bool filled = fill(blocks[block], lengths[block]);
+
+      pthread_mutex_lock(&mutex);
+      if (!filled) {
+        empty.push_back(block);
+        break;
+      }
+      full.push_back(block);
+      pthread_cond_broadcast(&changed);
+    }
+    finished = true;
+    pthread_cond_broadcast(&changed);
+    pthread_mutex_unlock(&mutex);
+  }
+#endif
+
+  // releases the current buffer, and gets the next full one
+  bool next(const char* &begin, const char* &end) {
+#ifdef THREADS_ARE_ABSENT
+    current = 0;
+    if (!fill(blocks[0], lengths[0]))
+      return false;
+#else
+    pthread_mutex_lock(&mutex);
+    if (current >= 0) {
+      empty.push_back(current);
+      current = -1;
+      pthread_cond_broadcast(&changed);
+    }
+    while (full.empty() && !finished)
+      pthread_cond_wait(&changed, &mutex);
+    if (full.empty()) {
+      pthread_mutex_unlock(&mutex);
+      return false;
+    }
+    current = full.front();
+    full.pop_front();
+    pthread_mutex_unlock(&mutex);
+#endif
+    begin = &blocks[current][0];
+    end = begin + lengths[current];
+    return true;
+  }
+
+  bool failed() {
+#ifdef THREADS_ARE_ABSENT
+    return error;
+#else
+    pthread_mutex_lock(&mutex);
+    const bool result = error;
+    pthread_mutex_unlock(&mutex);
+    return result;
+#endif
+  }
+};
+
+TextInput::TextInput()
+  : fileRead(false), reader(NULL)
+{
+}
+
+TextInput::~TextInput()
+{
+  close();
+}
+
+bool TextInput::open(const std::string &newFilename)
+{
+  close();
+
+  filename = newFilename;
+  if (filename == "-") {
+    reader = new Reader(0, false);
+    return true;
+  }
+
+  int fd = ::open(filename.c_str(), O_RDONLY | O_BINARY);
+  if (fd < 0) {
+    filename = newFilename + ".gz";
+    fd = ::open(filename.c_str(), O_RDONLY | O_BINARY);
+    if (fd < 0) {
+      filename = newFilename;
+      return false;
+    }
+  }
+
+  // pipes and the like are read as they are written
+  struct stat status;
+  if ((fstat(fd, &status) != 0) || !S_ISREG(status.st_mode)) {
+    reader = new Reader(fd, true);
+    return true;
+  }
+
+  // a gzip file begins with the bytes 0x1f 0x8b
+  unsigned char magic[2];
+  const bool compressed = (::read(fd, magic, 2) == 2) && (magic[0] == 0x1f)
+    && (magic[1] == 0x8b);
+  if (!compressed) {
+    ::close(fd);
+    return file.open(filename);
+  }
+
+#ifdef ZLIB_IS_ABSENT
+  ::close(fd);
+  return false;
+#else
+  if (lseek(fd, 0, SEEK_SET) != 0) {
+    ::close(fd);
+    return false;
+  }
+  reader = new Reader(fd, true);
+  return true;
+#endif
+}
+
+void TextInput::close()
+{
+  delete reader;
+  reader = NULL;
+  file.close();
+  fileRead = false;
+}
+
+bool TextInput::nextBlock(const char* &begin, const char* &end)
+{
+  if (reader != NULL) {
+    if (reader->next(begin, end))
+      return true;
+    begin = end = NULL;
+    return false;
+  }
+  if (fileRead || (file.size() == 0)) {
+    begin = end = NULL;
+    return false;
+  }
+  fileRead = true;
+  begin = file.begin();
+  end = file.end();
+  return true;
+}
+
+void TextInput::rewind()
+{
+  if (reader == NULL) {
+    fileRead = false;
+    return;
+  }
+  // read the file once more (standard input can't be read again)
+  const std::string streamedFilename(filename);
+  close();
+  if (streamedFilename != "-")
+    open(streamedFilename);
+}
+
+bool TextInput::failed() const
+{
+  if (reader != NULL)
+    return reader->failed();
+  return false;
+}
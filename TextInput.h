@@ -0,0 +1,102 @@
+#ifndef __TEXTINPUT_H
+#define __TEXTINPUT_H
+
+#include <string>
+#include "MappedFile.h"
+
+/** \brief The text of an input file, in blocks of whole lines.
+ *
+ * The text readers (see GraphInputPrism and GraphInputAut) get their files
+ * by a TextInput, block by block (see nextBlock()), and parse each block by
+ * a TextScanner.
+ *
+ * A plain file is mapped into memory (see MappedFile), and it is handed out
+ * as one single block. All other files are streamed: A gzip-compressed file
+ * (recognized by its first bytes, not by its name), standard input (the
+ * filename "-") and pipes are read by a separate thread into a few buffers
+ * while they are parsed, and compressed files are inflated on the way. So
+ * reading, inflating and parsing overlap, the text never has to be held in
+ * memory (or on disk) as a whole, and a pipe is parsed while the program
+ * writing it is still running. Each block ends behind a '\\n', except the
+ * last block of the file, so no line is split between two blocks.
+ *
+ * If ZLIB_IS_ABSENT is defined, compressed files can't be read. If
+ * THREADS_ARE_ABSENT is defined, the blocks are read in nextBlock().
+ */
+class TextInput {
+  public:
+    /// Constructor, nothing is opened yet
+    TextInput();
+
+    /// Destructor, closes the file (see close())
+    ~TextInput();
+
+    /** \brief Open the file with the given name.
+     *
+     * The filename "-" stands for standard input. If there is no such file,
+     * but one with the suffix ".gz" appended to the name, this one is
+     * opened. An open file is closed before.
+     *
+     * @return false, if the file could not be opened
+     */
+    bool open(const std::string &filename);
+
+    /// Close the file (and stop reading it)
+    void close();
+
+    /// The name of the opened file (maybe with the suffix ".gz")
+    const std::string& getFilename() const {
+      return filename;
+    }
+
+    /** \brief Is the file streamed?
+     *
+     * The readers parse a streamed file only once: a compressed file would
+     * have to be decompressed once more, and standard input or a pipe can't
+     * be read again at all (see rewind()).
+     */
+    bool isStreamed() const {
+      return reader != NULL;
+    }
+
+    /** \brief Get the next block of the text
+     *
+     * The previous block is released, so its memory must not be used
+     * anymore.
+     *
+     * @return false (and begin and end are set to NULL), if the whole file
+     *         has been read (or an error occurred, see failed())
+     */
+    bool nextBlock(const char* &begin, const char* &end);
+
+    /** \brief Start again with the first block
+     *
+     * A streamed file is read once more, except standard input: there are
+     * no more blocks then.
+     */
+    void rewind();
+
+    /// Did reading or decompressing the file fail?
+    bool failed() const;
+
+  private:
+    // not copyable
+    TextInput(const TextInput&);
+    TextInput& operator=(const TextInput&);
+
+    // reads (and inflates) a streamed file, see TextInput.cc
+    struct Reader;
+
+    // the name of the opened file
+    std::string filename;
+
+    // the plain file, and whether its one block has been handed out
+    MappedFile file;
+    bool fileRead;
+
+    // the reading of a streamed file, or NULL
+    Reader* reader;
+
+};
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef __TEXTSCANNER_H
+#define __TEXTSCANNER_H
+
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+/** \brief Reads numbers from lines of text in memory.
+ *
+ * The GraphInput classes use a TextScanner for parsing the contents of a
+ * MappedFile: the numbers are converted directly from the bytes of the file,
+ * without copying the lines into strings or streams. The text needn't be
+ * terminated by a '\\0' character.
+ *
+ * Blanks (spaces, tabs and carriage returns) between the numbers are skipped,
+ * lines are separated by '\\n'. The TextScanner counts the lines, so errors
+ * can be reported with their line number.
+ */
+class TextScanner {
+  public:
+    /// Constructor for the text from begin up to (but excluding) end
+    TextScanner(const char* begin, const char* end)
+      : position(begin), end(end), lineBegin(begin), lineNumber(1)
+    {
+    }
+
+    /// Is the whole text read?
+    bool atEnd() const {
+      return position == end;
+    }
+
+    /// Is the actual line read? (up to the '\\n' or the end of the text)
+    bool atLineEnd() const {
+      return (position == end) || (*position == '\n');
+    }
+
+    /// The actual position in the text
+    const char* getPosition() const {
+      return position;
+    }
+
+    /// The end of the actual line (its '\\n' or the end of the text)
+    const char* getLineEnd() const {
+      return findLineEnd(position);
+    }
+
+    /** \brief Continue reading at the given position
+     *
+     * The position must be in the actual line, between the actual position
+     * and getLineEnd().
+     */
+    void setPosition(const char* newPosition) {
+      position = newPosition;
+    }
+
+    /// The number of the actual line
+    unsigned int getLineNumber() const {
+      return lineNumber;
+    }
+
+    /// Returns the whole actual line, without the '\\n'
+    std::string getLine() const {
+      return std::string(lineBegin, findLineEnd(lineBegin));
+    }
+
+    /// Skips the rest of the actual line, including its '\\n'
+    void nextLine() {
+      const char* lineEnd = findLineEnd(position);
+      position = lineBegin = (lineEnd != end ? lineEnd + 1 : end);
+      ++lineNumber;
+    }
+
+    /// Skips the blanks at the actual position
+    void skipBlanks() {
+      while ((position != end) && isBlank(*position))
+        ++position;
+    }
+
+    /** \brief Skips the given character
+     *
+     * @return false (and nothing is skipped), if the character at the actual
+     *         position is a different one
+     */
+    bool skip(const char &c) {
+      if ((position == end) || (*position != c))
+        return false;
+      ++position;
+      return true;
+    }
+
+    /** \brief Reads an unsigned decimal number, after skipping blanks.
+     *
+     * @return false, if there is no number or it's too large
+     */
+    bool readUnsigned(unsigned int &value) {
+      skipBlanks();
+      if ((position != end) && (*position == '+'))
+        ++position;
+      if ((position == end) || !isDigit(*position))
+        return false;
+      unsigned int result = 0;
+      for (; (position != end) && isDigit(*position); ++position) {
+        const unsigned int digit = *position - '0';
+        if (result > (~0u - digit) / 10)
+          return false;
+        result = 10 * result + digit;
+      }
+      value = result;
+      return true;
+    }
+
+    /** \brief Reads a floating point number, after skipping blanks.
+     *
+     * The result is the same as reading it with <tt>operator>></tt> from a
+     * stream: Numbers with up to 15 digits and without exponent are
+     * converted directly (this is exact), the others by strtod().
+     *
+     * @return false, if there is no number
+     */
+    bool readDouble(double &value) {
+      skipBlanks();
+      const char* begin = position;
+      while ((position != end) && isNumberChar(*position))
+        ++position;
+      if (position == begin)
+        return false;
+
+      // fast path: [sign] digits [. digits]
+      const char* c = begin;
+      const bool negative = (*c == '-');
+      if ((*c == '-') || (*c == '+'))
+        ++c;
+      double mantissa = 0.0;
+      unsigned int noDigits = 0, noFractionDigits = 0;
+      bool point = false;
+      for (; c != position; ++c) {
+        if (isDigit(*c)) {
+          mantissa = 10.0 * mantissa + (*c - '0');
+          ++noDigits;
+          if (point)
+            ++noFractionDigits;
+        } else if ((*c == '.') && !point)
+          point = true;
+        else
+          break;
+      }
+      if ((c == position) && (noDigits > 0) && (noDigits <= 15)) {
+        // both mantissa and the power of ten are exact, so the quotient is
+        // rounded correctly
+        static const double powersOfTen[16] = { 1e0, 1e1, 1e2, 1e3, 1e4,
+          1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+        value = mantissa / powersOfTen[noFractionDigits];
+        if (negative)
+          value = -value;
+        return true;
+      }
+
+      // slow path, strtod needs a terminated string
+      char buffer[128];
+      const std::string::size_type length = position - begin;
+      if (length >= sizeof(buffer))
+        return false;
+      memcpy(buffer, begin, length);
+      buffer[length] = '\0';
+      char* parsed;
+      value = strtod(buffer, &parsed);
+      return parsed == buffer + length;
+    }
+
+  private:
+    // the first '\n' from the given position on, or the end of the text
+    // (which may be NULL, if the text is empty)
+    const char* findLineEnd(const char* from) const {
+      if (from == end)
+        return end;
+      const char* lineEnd = static_cast<const char*>(
+          memchr(from, '\n', end - from));
+      return lineEnd != NULL ? lineEnd : end;
+    }
+
+    static bool isBlank(const char &c) {
+      return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\v')
+        || (c == '\f');
+    }
+
+    static bool isDigit(const char &c) {
+      return (c >= '0') && (c <= '9');
+    }
+
+    // characters that may be part of a floating point number
+    static bool isNumberChar(const char &c) {
+      return isDigit(c) || (c == '.') || (c == '-') || (c == '+')
+        || (c == 'e') || (c == 'E');
+    }
+
+    // the actual position, and the end of the text
+    const char* position;
+    const char* end;
+
+    // the beginning and the number of the actual line
+    const char* lineBegin;
+    unsigned int lineNumber;
+
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include "ThreadPool.h"
+#include <cstddef>
+
+ThreadPool::ThreadPool(const unsigned int &noThreads)
+  : noThreads(noThreads > 0 ? noThreads : 1), job(NULL), noChunks(0),
+    nextChunk(0)
+{
+#ifdef THREADS_ARE_ABSENT
+  this->noThreads = 1;
+#else
+  generation = 0;
+  busy = 0;
+  stop = false;
+  pthread_mutex_init(&mutex, NULL);
+  pthread_cond_init(&started, NULL);
+  pthread_cond_init(&finished, NULL);
+
+  // the calling thread is worker 0
+  threads.resize(this->noThreads - 1);
+  arguments.resize(this->noThreads - 1);
+  for (unsigned int worker = 1; worker < this->noThreads; ++worker) {
+    arguments[worker - 1].pool = this;
+    arguments[worker - 1].worker = worker;
+    if (pthread_create(&threads[worker - 1], NULL, threadMain,
+          &arguments[worker - 1]) != 0) {
+      // go on with the threads started so far
+      threads.resize(worker - 1);
+      this->noThreads = worker;
+      break;
+    }
+  }
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+#ifndef THREADS_ARE_ABSENT
+  pthread_mutex_lock(&mutex);
+  stop = true;
+  pthread_cond_broadcast(&started);
+  pthread_mutex_unlock(&mutex);
+  for (std::vector<pthread_t>::const_iterator thread = threads.begin();
+      thread != threads.end(); ++thread)
+    pthread_join(*thread, NULL);
+  pthread_cond_destroy(&finished);
+  pthread_cond_destroy(&started);
+  pthread_mutex_destroy(&mutex);
+#endif
+}
+
+unsigned int ThreadPool::getThreadNumber() const
+{
+  return noThreads;
+}
+
+void ThreadPool::run(Job &newJob, const unsigned int &newNoChunks)
+{
+  job = &newJob;
+  noChunks = newNoChunks;
+  nextChunk = 0;
+
+#ifndef THREADS_ARE_ABSENT
+  // only wake up the worker threads if there is work for them
+  if (!threads.empty() && (noChunks > 1)) {
+    pthread_mutex_lock(&mutex);
+    busy = threads.size();
+    ++generation;
+    pthread_cond_broadcast(&started);
+    pthread_mutex_unlock(&mutex);
+
+    work(0);
+
+    pthread_mutex_lock(&mutex);
+    while (busy > 0)
+      pthread_cond_wait(&finished, &mutex);
+    pthread_mutex_unlock(&mutex);
+    job = NULL;
+    return;
+  }
+#endif
+
+  work(0);
+  job = NULL;
+}
+
+void ThreadPool::work(const unsigned int &worker)
+{
+#ifdef THREADS_ARE_ABSENT
+  for (unsigned int chunk = 0; chunk < noChunks; ++chunk)
+    job->execute(chunk, worker);
+#else
+  for (unsigned int chunk = __sync_fetch_and_add(&nextChunk, 1);
+      chunk < noChunks; chunk = __sync_fetch_and_add(&nextChunk, 1))
+    job->execute(chunk, worker);
+#endif
+}
+
+#ifndef THREADS_ARE_ABSENT
+void* ThreadPool::threadMain(void* arg)
+{
+  ThreadPool* pool = static_cast<WorkerArgument*>(arg)->pool;
+  const unsigned int worker = static_cast<WorkerArgument*>(arg)->worker;
+  unsigned long seenGeneration = 0;
+
+  while (true) {
+    pthread_mutex_lock(&pool->mutex);
+    while ((pool->generation == seenGeneration) && !pool->stop)
+      pthread_cond_wait(&pool->started, &pool->mutex);
+    if (pool->stop) {
+      pthread_mutex_unlock(&pool->mutex);
+      return NULL;
+    }
+    seenGeneration = pool->generation;
+    pthread_mutex_unlock(&pool->mutex);
+
+    pool->work(worker);
+
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->busy == 0)
+      pthread_cond_signal(&pool->finished);
+    pthread_mutex_unlock(&pool->mutex);
+  }
+}
+#endif
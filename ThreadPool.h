@@ -0,0 +1,109 @@
+#ifndef __THREADPOOL_H
+#define __THREADPOOL_H
+
+#include <vector>
+#ifndef THREADS_ARE_ABSENT
+  #include <pthread.h>
+#endif
+
+/** \brief A fixed set of worker threads that execute jobs in chunks.
+ *
+ * A Job consists of a number of independent chunks. run() hands the chunks
+ * out to the worker threads and to the calling thread: each of them takes
+ * the next unhandled chunk (by an atomic counter) as soon as it has
+ * finished its last one, so the load is balanced dynamically. run()
+ * returns when all chunks have been executed.
+ *
+ * If THREADS_ARE_ABSENT is defined, or the ThreadPool has been created for
+ * one thread, all chunks are executed by the calling thread.
+ */
+class ThreadPool {
+  public:
+
+    /// A job for the ThreadPool
+    class Job {
+      public:
+        /// Destructor
+        virtual ~Job() {}
+
+        /** \brief Execute one chunk of the Job
+         *
+         * Is called concurrently for different chunks.
+         *
+         * @param chunk  The number of the chunk
+         * @param worker The number of the executing thread, between 0 and
+         *               ThreadPool::getThreadNumber() - 1 (0 is the thread
+         *               that called ThreadPool::run())
+         */
+        virtual void execute(const unsigned int &chunk,
+            const unsigned int &worker) = 0;
+    };
+
+    /** \brief Constructor, starts the worker threads
+     *
+     * @param noThreads The number of threads that execute the chunks,
+     *                  including the thread that calls run()
+     */
+    ThreadPool(const unsigned int &noThreads = 1);
+
+    /// Destructor, stops the worker threads
+    ~ThreadPool();
+
+    /// Returns the number of threads (including the calling thread)
+    unsigned int getThreadNumber() const;
+
+    /** \brief Execute all chunks of a Job
+     *
+     * @param job      The Job to execute
+     * @param noChunks The number of chunks, they are numbered from 0 to
+     *                 noChunks - 1
+     */
+    void run(Job &job, const unsigned int &noChunks);
+
+  private:
+    // not copyable
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    // executes chunks of the actual job until there are no more
+    void work(const unsigned int &worker);
+
+#ifndef THREADS_ARE_ABSENT
+    // the main function of the worker threads, `arg` is a WorkerArgument
+    static void* threadMain(void* arg);
+
+    // argument of threadMain()
+    struct WorkerArgument {
+      ThreadPool* pool;
+      unsigned int worker;
+    };
+
+    std::vector<pthread_t> threads;
+    std::vector<WorkerArgument> arguments;
+
+    // protects the following attributes
+    pthread_mutex_t mutex;
+    // signalled when a job is started (or the threads shall stop)
+    pthread_cond_t started;
+    // signalled when the last worker thread has finished the job
+    pthread_cond_t finished;
+
+    // incremented for each job
+    unsigned long generation;
+    // number of worker threads that haven't finished the actual job
+    unsigned int busy;
+    // set, if the threads shall stop
+    bool stop;
+#endif
+
+    // the number of threads, including the calling thread
+    unsigned int noThreads;
+
+    // the actual job, its number of chunks, and the next unhandled chunk
+    Job* job;
+    unsigned int noChunks;
+    volatile unsigned int nextChunk;
+
+};
+
+#endif
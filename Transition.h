@@ -17,8 +17,6 @@ class Transition {
     /// Copy constructor
     Transition(const Transition&);
     /// Another constructor that sets target State and Label.
-    Transition(State *const &target, const std::string &l);
-    /// Another constructor that sets target State and Label.
     Transition(State *const &target, Label *const &l);
 
     /// Destructor
@@ -54,8 +52,6 @@ class Transition {
 
     /// Sets a new Label.
     void setLabel(Label *const &newLabel);
-    /// Sets a new Label.
-    void setLabel(const std::string &newLabel);
 
     /// Equality operator
     bool operator==(const Transition &compTrans) const;
@@ -30,10 +30,17 @@ int main (int argc, char *argv[]) {
 
   std::string inputFilename,
     outputFilenames,
+    snapshotFilename,
     theAction;
 
+  // the propositions to write to the .lab files
+  std::vector<std::string> labPropositions;
+
   bool computeLabels(true), deleteUnreachable(false), cycleSearch(true),
-       searchAbsorbing(false), uniformize(true);
+       deferredCycleSearch(false), searchAbsorbing(false), uniformize(true),
+       reachableOnly(false), minimize(false), lump(false),
+       tauReduction(false);
+  unsigned int threads(1);
 
   /*
    * Parsing the input arguments.
@@ -44,17 +51,25 @@ int main (int argc, char *argv[]) {
     { "delete-unreachable", no_argument,       0, 'd' },
     { "input",              required_argument, 0, 'i' },
     { "no-cycle-search",    no_argument,       0, 'k' },
+    { "deferred-cycle-search", no_argument,    0, 'K' },
     { "no-labels",          no_argument,       0, 'l' },
+    { "lump",               no_argument,       0, 'L' },
+    { "minimize",           no_argument,       0, 'm' },
     { "output",             required_argument, 0, 'o' },
     { "no-uniformize",      no_argument,       0, 'n' },
+    { "propositions",       required_argument, 0, 'p' },
+    { "reachable-only",     no_argument,       0, 'r' },
     { "search-absorbing",   no_argument,       0, 's' },
+    { "snapshot",           required_argument, 0, 'S' },
+    { "threads",            required_argument, 0, 't' },
+    { "tau-reduction",      no_argument,       0, 'T' },
     { "help"  ,             no_argument,       0, 'h' },
     { 0, 0, 0, 0 }
   };
 
   while (optind < argc) {
     int index = -1;
-    int result = getopt_long(argc, argv, "a:cdi:klo:nsh",
+    int result = getopt_long(argc, argv, "a:cdi:kKlLmo:np:rsS:t:Th",
                              long_options, &index);
     if (result == -1) break; // end of list
     switch (result) {
@@ -73,18 +88,59 @@ int main (int argc, char *argv[]) {
       case 'k':
         cycleSearch = false;
         break;
+      case 'K':
+        deferredCycleSearch = true;
+        break;
       case 'l':
         computeLabels = false;
         break;
+      case 'L':
+        lump = true;
+        break;
+      case 'm':
+        minimize = true;
+        break;
       case 'o':
         outputFilenames = optarg;
         break;
       case 'n':
         uniformize = false;
         break;
+      case 'p': {
+        std::string names(optarg);
+        std::string::size_type begin = 0, comma;
+        do {
+          comma = names.find(',', begin);
+          std::string name = names.substr(begin, comma == names.npos ?
+              names.npos : comma - begin);
+          if (!name.empty())
+            labPropositions.push_back(name);
+          begin = comma + 1;
+        } while (comma != names.npos);
+        break;
+      }
+      case 'r':
+        reachableOnly = true;
+        break;
       case 's':
         searchAbsorbing = true;
         break;
+      case 'S':
+        snapshotFilename = optarg;
+        break;
+      case 't': {
+        char* end;
+        const long number = strtol(optarg, &end, 10);
+        if ((*optarg == '\0') || (*end != '\0') || (number < 1)) {
+          fprintf(stderr, "Invalid number of threads: \"%s\"\n", optarg);
+          exit(-1);
+        }
+        threads = number;
+        break;
+      }
+      case 'T':
+        tauReduction = true;
+        break;
       case 'h':
         printHelp(argv[0]);
         return 0;
@@ -107,10 +163,17 @@ int main (int argc, char *argv[]) {
   }
 
   std::string default_filename(inputFilename);
+  // a compressed input file is named like the uncompressed one plus ".gz"
+  if ((default_filename.size() > 3)
+      && (default_filename.substr(default_filename.size() - 3) == ".gz"))
+    default_filename.erase(default_filename.size() - 3);
   if (default_filename.rfind('.') != default_filename.npos)
     default_filename.erase(default_filename.rfind('.'));
   if (default_filename.find(':') != default_filename.npos)
     default_filename.erase(0, default_filename.find(':') + 1);
+  // standard input has no name
+  if (default_filename == "-")
+    default_filename = "stdin";
   default_filename.append("_ctmdp");
 
   if (outputFilenames.empty())
@@ -121,7 +184,10 @@ int main (int argc, char *argv[]) {
 #endif
     // set options
     Graph::setCycleSearch(cycleSearch);
+    Graph::setDeferredCycleSearch(deferredCycleSearch);
     Graph::setSearchForAbsorbingStates(searchAbsorbing);
+    Graph::setLabPropositions(labPropositions);
+    Graph::setThreads(threads);
     Graph::setAction(theAction);
     if (noColor) {
       colorGreen = colorRed = colorPurple = colorReset = colorGrayBg =
@@ -134,6 +200,15 @@ int main (int argc, char *argv[]) {
     countTime("Reading input file");
     std::pair<std::string, std::string> inputFormat = getFormat(inputFilename,
         default_filename);
+    // the format of a compressed file is given by its inner extension
+    if (inputFormat.first == "gz")
+      inputFormat.first = getFormat(inputFilename.substr(0,
+            inputFilename.size() - 3), default_filename).first;
+    if (inputFormat.first.empty() && (inputFormat.second == "-")) {
+      Graph::warn("The format of standard input must be given, e.g. "
+          "\"aut:-\", exiting.");
+      exit(-1);
+    }
     if (inputFormat.first.empty()) {
       //Graph::warn("Warning: Couldn't extract format of file \"%s\".",
       //    inputFilename.c_str());
@@ -148,28 +223,53 @@ int main (int argc, char *argv[]) {
       exit(-1);
     }
 
-    if (deleteUnreachable) {
+    if (!snapshotFilename.empty()) {
+      countTime("Writing snapshot of the IMC");
+      graph->write("imcsnap", snapshotFilename);
+    }
+
+    if (deleteUnreachable && !reachableOnly) {
       countTime("Deleting unreachable states (#1, before transformation)");
       graph->deleteUnreachable();
     }
 
-    countTime("Checking uniformity");
-    {
-      double maxOutgoingRate;
-      bool uniform = graph->checkUniformity(true, &maxOutgoingRate);
-      if (!uniform && uniformize) {
-        countTime("Uniformizing IMC");
-        graph->uniformize(maxOutgoingRate);
-        assert(graph->checkUniformity(true));
-      }
+    if (tauReduction) {
+      countTime("Reducing tau transitions");
+      graph->reduceTau();
     }
 
-    countTime("Transforming IMC to CTMDP");
-    graph->transformImcToCtmdp(computeLabels);
+    if (minimize) {
+      countTime("Minimizing IMC (strong bisimulation)");
+      graph->minimize();
+    }
 
-    if (deleteUnreachable) {
-      countTime("Deleting unreachable states (#2, after transformation)");
-      graph->deleteUnreachable();
+    if (reachableOnly) {
+      countTime("Transforming the reachable part of the IMC to a CTMDP");
+      graph->transformReachable(computeLabels, uniformize);
+    } else {
+      countTime("Checking uniformity");
+      {
+        double maxOutgoingRate;
+        bool uniform = graph->checkUniformity(true, &maxOutgoingRate);
+        if (!uniform && uniformize) {
+          countTime("Uniformizing IMC");
+          graph->uniformize(maxOutgoingRate);
+          assert(graph->checkUniformity(true));
+        }
+      }
+
+      countTime("Transforming IMC to CTMDP");
+      graph->transformImcToCtmdp(computeLabels);
+
+      if (deleteUnreachable) {
+        countTime("Deleting unreachable states (#2, after transformation)");
+        graph->deleteUnreachable();
+      }
+    }
+
+    if (lump) {
+      countTime("Lumping CTMDP");
+      graph->minimize();
     }
 
     countTime("Checking for internal nondeterminism");
@@ -308,16 +408,35 @@ void printHelp(const char* firstArg)
 "      search for and delete unreachable states\n"
 "\n"
 "   -i, --input=filename[.bcg]\n"
-"      the input filename. If no extension is given, \".bcg\" will be appended"
+"      the input filename. If no extension is given, \".bcg\" will be appended."
 "\n"
+"      The text formats (\"aut\" and the PRISM files) may be compressed by\n"
+"      gzip, with the extension \".gz\" appended (e.g. \"model.aut.gz\").\n"
+"      The filename \"-\" reads an aut file from standard input (\"aut:-\"),\n"
+"      which is converted while it is written\n"
 "\n"
 "   -k, --no-cycle-search\n"
 "      don't search for interactive cycles (do only use if you know that no\n"
 "      interactive cycles exist, otherwise the program may fail)\n"
 "\n"
+"   -K, --deferred-cycle-search\n"
+"      don't search for interactive cycles while reading the input file, but\n"
+"      break them in one pass after reading it (faster if there are no or\n"
+"      only few interactive cycles)\n"
+"\n"
 "   -l, --no-labels\n"
 "      don't compute labels for markov successors of interactive states\n"
 "\n"
+"   -L, --lump\n"
+"      merge the equivalent states of the CTMDP after converting it: states\n"
+"      with the same actions into equivalent states, or with the same sums\n"
+"      of rates into each class of equivalent states. This runs on one\n"
+"      thread, regardless of -t\n"
+"\n"
+"   -m, --minimize\n"
+"      merge the strongly bisimilar states of the IMC before converting it\n"
+"      (states with different marks or propositions are never merged)\n"
+"\n"
 "   -n, --no-uniformize\n"
 "      per default, the IMC is uniformized. By this option, you can\n"
 "      disable this feature\n"
@@ -325,9 +444,37 @@ void printHelp(const char* firstArg)
 "   -o, --output=filenames\n"
 "      see below for more information\n"
 "\n"
+"   -p, --propositions=NAMES\n"
+"      write the labels of the PRISM labels file with the given comma\n"
+"      separated NAMES (or \"all\" of them) to the .lab file\n"
+"\n"
+"   -r, --reachable-only\n"
+"      convert only the part of the IMC that is reachable from the initial\n"
+"      state, in one search that uniformizes, computes the markov successors\n"
+"      and numbers the states at once (like \"-d\", but faster). Only the\n"
+"      reached markov states are uniformized, so if the IMC is not uniform,\n"
+"      the uniform rate may be lower and the CTMDP differs from the one of\n"
+"      \"-d\" (unless \"-n\" is given)\n"
+"\n"
 "   -s, --search-absorbing\n"
 "      search for absorbing states and label them in the .lab file\n"
 "\n"
+"   -S, --snapshot=filename\n"
+"      write the IMC to filename in the binary \"imcsnap\" format, just after\n"
+"      reading it. Converting the snapshot (\"-i imcsnap:filename\") is much\n"
+"      faster than converting the original input file again\n"
+"\n"
+"   -t, --threads=NUMBER\n"
+"      parse the PRISM transitions file and compute the markov successors of\n"
+"      the interactive states with NUMBER threads (default: 1). The result\n"
+"      does not depend on NUMBER. The other steps (e.g. -m and -L) run on\n"
+"      one thread\n"
+"\n"
+"   -T, --tau-reduction\n"
+"      cut off the markov transitions of hybrid states (maximal progress) and\n"
+"      collapse the tau transitions that are the only transition of their\n"
+"      state, before converting the IMC\n"
+"\n"
 "   -h, --help\n"
 "      print this help\n"
 "\n"
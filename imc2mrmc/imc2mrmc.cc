@@ -1,8 +1,11 @@
 #include "imc2mrmc.h"
 #include <string>
+#include <vector>
+#include <algorithm>
 #include "../Graph.h"
 #include "../State.h"
 #include "../Transition.h"
+#include "../GraphCSR.h"
 #include "../GraphInputBCG.h"
 #include "../GraphInputPrism.h"
 
@@ -101,52 +104,53 @@ std::pair<std::string, std::string> getFormat(const std::string &filename,
 
 
 
+// needed for readSparse(): compares (action number, (target, rate)) pairs
+// by the action number and the target
+struct compareActionTarget {
+  bool operator() (const std::pair<int, std::pair<int, double> > &a1,
+      const std::pair<int, std::pair<int, double> > &a2) const {
+    return (a1.first < a2.first)
+      || ((a1.first == a2.first) && (a1.second.first < a2.second.first));
+  }
+};
+
 mdp_sparse* readSparse(Graph* graph) {
 
-  std::vector<State*>* states = graph->getStates();
+  // after sortStatesByNr(), the index of each State is its number
+  const GraphCSR &states = graph->getCSR();
 
   // get number of interactive States
   int nrInteractiveStates(0);
-  for (std::vector<State*>::const_iterator state = states->begin();
-      state != states->end(); ++state) {
-    if ((*state)->getType() != State::INTERACTIVE)
+  for (unsigned int state = 0; state < states.getStateNumber(); ++state) {
+    if (states.getType(state) != State::INTERACTIVE)
       break;
     ++nrInteractiveStates;
   }
 
   
-  // Map of all actions and their internal number
+  // the internal number of each action, by its Label number (-1 if the
+  // Label isn't an action)
   int nextActionNumber = 0;
-  std::map<std::string, int> allActions;
+  std::vector<int> actionNumbers(states.getLabelNumber(), -1);
+  std::vector<unsigned int> actionLabels;
 
   // search for all action labels
-  int toDo = nrInteractiveStates;
-  for (std::vector<State*>::const_iterator state = states->begin();
-      toDo != 0; ++state, --toDo) {
-
-    for (std::vector<Transition*>::const_iterator trans =
-        (*state)->getTransitions()->begin();
-        trans != (*state)->getTransitions()->end();
-        ++trans) {
-      const std::string action = (*trans)->getLabel()->str();
-      std::map<std::string, int>::iterator found = allActions.find(action);
-      if (found == allActions.end())
-        allActions.insert(std::make_pair(action, nextActionNumber++));
+  for (int state = 0; state < nrInteractiveStates; ++state) {
+    for (unsigned int trans = states.getTransitionsBegin(state);
+        trans != states.getTransitionsEnd(state); ++trans) {
+      int &actionNr = actionNumbers[states.getLabelId(trans)];
+      if (actionNr < 0) {
+        actionNr = nextActionNumber++;
+        actionLabels.push_back(states.getLabelId(trans));
+      }
     }
   }
 
   // create MRMC labelset
   mdp_labelset* labels = mdp_labelset_new(nextActionNumber);
-  {
-    std::vector<std::string> actionsByNr(nextActionNumber, std::string());
-    for (std::map<std::string, int>::const_iterator it = allActions.begin();
-        it != allActions.end(); ++it)
-      actionsByNr[it->second] = it->first;
-
-    for (std::vector<std::string>::const_iterator it = actionsByNr.begin();
-        it != actionsByNr.end(); ++it)
-      mdp_labelset_add(labels, it->c_str());
-  }
+  for (std::vector<unsigned int>::const_iterator it = actionLabels.begin();
+      it != actionLabels.end(); ++it)
+    mdp_labelset_add(labels, states.getLabelById(*it)->str().c_str());
 
   // create mdp sparse structure
   mdp_sparse* sparse = (mdp_sparse*)malloc(sizeof(mdp_sparse));
@@ -159,39 +163,29 @@ mdp_sparse* readSparse(Graph* graph) {
   bool firstOutgoingRate = true;
 
   // and now the main work...
-  toDo = nrInteractiveStates;
-  for (std::vector<State*>::const_iterator state = states->begin();
-      toDo > 0; ++state, --toDo) {
-
-    // all actions available from this State, and their probability to get
-    // to another State
-    // a map from action numbers (label numbers) to a map from states to
-    // propabilities
-    std::map<int, std::map<int, double> > actions;
-
-    std::vector<Transition*>* transitions = (*state)->getTransitions();
-
-    for (std::vector<Transition*>::const_iterator trans = transitions->begin();
-        trans != transitions->end(); ++trans) {
-
-      State* target = (*trans)->getTargetState();
-      std::string label = (*trans)->getLabel()->str();
-      int actionNr = allActions[label];
-
-
-      for (std::vector<Transition*>::const_iterator mTrans =
-          target->getTransitions()->begin();
-          mTrans != target->getTransitions()->end();
-          ++mTrans) {
-
-        // add the found transition to the vector
-        actions[actionNr][(*mTrans)->getTargetState()->getNumber()] +=
-          (*mTrans)->getRate();
-      }
+  // all actions available from a State, and their probability to get to
+  // another State: (action number, (target State, rate)), sorted
+  std::vector< std::pair<int, std::pair<int, double> > > actions;
+  for (int state = 0; state < nrInteractiveStates; ++state) {
+
+    actions.clear();
+    for (unsigned int trans = states.getTransitionsBegin(state);
+        trans != states.getTransitionsEnd(state); ++trans) {
+
+      const unsigned int target = states.getTarget(trans);
+      const int actionNr = actionNumbers[states.getLabelId(trans)];
+
+      for (unsigned int mTrans = states.getTransitionsBegin(target);
+          mTrans != states.getTransitionsEnd(target); ++mTrans)
+        actions.push_back(std::make_pair(actionNr, std::make_pair(
+                (int)states.getTarget(mTrans), states.getRate(mTrans))));
     }
+    // (the rates to the same target are added in the order of the
+    // Transitions)
+    std::stable_sort(actions.begin(), actions.end(), compareActionTarget());
 
     // dump the transitions/actions vector
-    int stateNr = (*state)->getNumber();
+    int stateNr = states.getNumber(state);
 
     sparse->val[stateNr].col =
       (int**)calloc(nextActionNumber, sizeof(int *));
@@ -203,35 +197,45 @@ mdp_sparse* readSparse(Graph* graph) {
 
     // now save the found transitions in the MRMC data structure
     int lastActionNr = 0;
-    for (std::map<int, std::map<int, double> >::const_iterator it =
-        actions.begin(); it != actions.end(); ++it) {
+    unsigned int noActions = 0;
+    for (std::vector< std::pair<int, std::pair<int, double> > >::size_type
+        begin = 0, end = 0; begin < actions.size(); begin = end) {
 
-      int actionNr = it->first;
+      int actionNr = actions[begin].first;
       while (++lastActionNr < actionNr) {
         sparse->val[stateNr].col[lastActionNr] = (int*)calloc(0, sizeof(int));
         sparse->val[stateNr].val[lastActionNr] =
           (double*)calloc(0, sizeof(double));
         sparse->val[stateNr].val_sizes[lastActionNr] = 0;
       }
+      ++noActions;
 
-      const std::map<int, double> &targets = it->second;
+      // the different targets of the action
+      unsigned int noTargets = 0;
+      for (end = begin; (end < actions.size())
+          && (actions[end].first == actionNr); ++end)
+        if ((end == begin)
+            || (actions[end].second.first != actions[end-1].second.first))
+          ++noTargets;
 
       // the sum of outgoing transitions of the actual action laben
       double outgoingRate(0.0);
 
-      int*    cols = (int*)calloc(targets.size(), sizeof(int));
-      double* vals = (double*)calloc(targets.size(), sizeof(double));
-
-      sparse->val[stateNr].val_sizes[actionNr] = targets.size();
-      sparse->val[stateNr].size += targets.size();
-
-      int transNr = 0;
-
-      for (std::map<int, double>::const_iterator trans =
-          targets.begin(); trans != targets.end(); ++trans, ++transNr) {
-        cols[transNr] = trans->first;
-        vals[transNr] = trans->second;
-        outgoingRate += trans->second;
+      int*    cols = (int*)calloc(noTargets, sizeof(int));
+      double* vals = (double*)calloc(noTargets, sizeof(double));
+
+      sparse->val[stateNr].val_sizes[actionNr] = noTargets;
+      sparse->val[stateNr].size += noTargets;
+
+      // the rates to the same target are added
+      int transNr = -1;
+      for (std::vector< std::pair<int, std::pair<int, double> > >::size_type
+          trans = begin; trans < end; ++trans) {
+        if ((trans == begin)
+            || (actions[trans].second.first != actions[trans-1].second.first))
+          cols[++transNr] = actions[trans].second.first;
+        vals[transNr] += actions[trans].second.second;
+        outgoingRate += actions[trans].second.second;
       }
 
       sparse->val[stateNr].col[actionNr] = cols;
@@ -250,7 +254,7 @@ mdp_sparse* readSparse(Graph* graph) {
 
     }
 
-    while ((unsigned int)++lastActionNr < actions.size()) {
+    while ((unsigned int)++lastActionNr < noActions) {
       sparse->val[stateNr].col[lastActionNr] = (int*)calloc(0, sizeof(int));
       sparse->val[stateNr].val[lastActionNr] =
         (double*)calloc(0, sizeof(double));
@@ -0,0 +1,54 @@
+#!/bin/sh
+# Checks that a generated model (input format "queue", see
+# GraphGeneratorQueue) is converted exactly like the same IMC read from an
+# aut file, whose states are numbered in the order of the exploration.
+#
+# Usage: sh test/generator.sh [path/to/imc2ctmdp]
+
+BIN=${1:-./imc2ctmdp}
+DIR=`mktemp -d` || exit 1
+trap 'rm -rf "$DIR"' EXIT
+
+failed=0
+
+# the queue of capacity 2, the states are (jobs, busy): 0 = (0, no),
+# 1 = (1, no), 2 = (2, no), 3 = (1, yes), 4 = (2, yes)
+cat > "$DIR/queue.aut" <<'MODEL'
+des (0, 9, 5)
+(0, "rate 2", 1)
+(1, "rate 2", 2)
+(1, "serve", 3)
+(2, "serve", 4)
+(2, "full", 2)
+(3, "rate 2", 4)
+(3, "rate 3", 0)
+(4, "rate 3", 1)
+(4, "full", 4)
+MODEL
+
+# convert <name> <input> <options>: converts the input with the options
+convert() {
+  if ! "$BIN" -c $3 -a full -i "$2" \
+      -o "ctmdpi:$DIR/$1.ctmdpi,lab:$DIR/$1.lab,marked:$DIR/$1.marked" \
+      > "$DIR/log" 2>&1; then
+    cat "$DIR/log"
+    echo "FAILED: converting $2 with options \"$3\""
+    failed=1
+  fi
+}
+
+for options in "" "-d" "-r" "-n" "-m -L"; do
+  convert generated queue:N=2 "$options"
+  convert read "aut:$DIR/queue.aut" "$options"
+  for extension in ctmdpi lab marked; do
+    if ! cmp -s "$DIR/generated.$extension" "$DIR/read.$extension"; then
+      echo "FAILED: the $extension outputs differ with options \"$options\""
+      failed=1
+    fi
+  done
+done
+
+if [ $failed -eq 0 ]; then
+  echo "generator: all tests passed"
+fi
+exit $failed
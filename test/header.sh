@@ -0,0 +1,70 @@
+#!/bin/sh
+# Regression test for the text readers: a file header that overstates the
+# number of transitions has to be warned about, and the transitions that
+# are actually in the file have to be converted (the memory for the
+# transitions is not reserved from the header).
+#
+# Usage: sh test/header.sh [path/to/imc2ctmdp]
+
+BIN=${1:-./imc2ctmdp}
+DIR=`mktemp -d` || exit 1
+trap 'rm -rf "$DIR"' EXIT
+
+failed=0
+
+# the same IMC as an aut file and as PRISM files, both headers claim
+# 2000000000 transitions
+cat > "$DIR/model.aut" <<'MODEL'
+des (0, 2000000000, 2)
+(0, "rate 1", 1)
+(1, "a", 0)
+MODEL
+cat > "$DIR/model.prism" <<'MODEL'
+const double a = 1001; // Action "a"
+MODEL
+cat > "$DIR/model.trans" <<'MODEL'
+2 2000000000
+0 1 1
+1 0 1001
+MODEL
+cat > "$DIR/model.labels" <<'MODEL'
+0="init"
+0: 0
+MODEL
+cat > "$DIR/expected.ctmdpi" <<'MODEL'
+STATES 2
+#DECLARATION
+i
+a
+#END
+1 i
+* 2 1
+2 a
+* 2 1
+MODEL
+
+# convert <input>: converts the input, which has to be warned about
+convert() {
+  if ! "$BIN" -c -i "$1" -o "ctmdpi:$DIR/model.ctmdpi" > "$DIR/log" 2>&1; then
+    cat "$DIR/log"
+    echo "FAILED: converting $1"
+    failed=1
+  elif ! grep -q "Number of read transitions differs" "$DIR/log"; then
+    echo "FAILED: no warning about the header of $1"
+    failed=1
+  elif ! cmp -s "$DIR/expected.ctmdpi" "$DIR/model.ctmdpi"; then
+    echo "FAILED: the output of $1 differs"
+    failed=1
+  fi
+}
+
+convert "aut:$DIR/model.aut"
+convert "prism:$DIR/model.prism"
+if gzip -c "$DIR/model.aut" > "$DIR/compressed.aut.gz" 2> /dev/null; then
+  convert "aut:$DIR/compressed.aut.gz"
+fi
+
+if [ $failed -eq 0 ]; then
+  echo "header: all tests passed"
+fi
+exit $failed
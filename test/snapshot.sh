@@ -0,0 +1,86 @@
+#!/bin/sh
+# Regression test for the snapshot reader: corrupted snapshots have to be
+# rejected with an error message, instead of crashing the conversion.
+#
+# Usage: sh test/snapshot.sh [path/to/imc2ctmdp]
+
+BIN=${1:-./imc2ctmdp}
+DIR=`mktemp -d` || exit 1
+trap 'rm -rf "$DIR"' EXIT
+
+failed=0
+
+fail() {
+  echo "FAILED: $1"
+  failed=1
+}
+
+# a small IMC, state 1 is hybrid
+cat > "$DIR/model.aut" <<'MODEL'
+des (0, 7, 4)
+(0, "a", 1)
+(1, "rate 2", 2)
+(1, "b", 3)
+(2, "rate 1", 0)
+(2, "rate 0.5", 3)
+(0, "c", 2)
+(3, "rate 4", 1)
+MODEL
+
+if ! "$BIN" -c -i "aut:$DIR/model.aut" -S "$DIR/model.imcsnap" \
+    -o "ctmdpi:$DIR/model.ctmdpi" > "$DIR/log" 2>&1; then
+  cat "$DIR/log"
+  echo "FAILED: converting the model"
+  exit 1
+fi
+if ! "$BIN" -c -i "imcsnap:$DIR/model.imcsnap" \
+    -o "ctmdpi:$DIR/snapshot.ctmdpi" > "$DIR/log" 2>&1 \
+    || ! cmp -s "$DIR/model.ctmdpi" "$DIR/snapshot.ctmdpi"; then
+  fail "converting the valid snapshot"
+fi
+
+# the numbers of the header (see GraphSnapshotHeader), after the magic
+field() {
+  od -An -tu4 -j $((8 + 4 * $1)) -N4 "$DIR/model.imcsnap" | tr -d ' '
+}
+padded() {
+  echo $((($1 + 7) / 8 * 8))
+}
+noStates=`field 2`
+noLabels=`field 4`
+commentLength=`field 8`
+textLength=`field 9`
+
+# the offsets of the state sections
+numbers=$((48 + `padded $commentLength` + `padded $((8 * noLabels))` \
+  + `padded $textLength` + `padded $((4 * noStates + 4))`))
+origins=$((numbers + `padded $((4 * noStates))`))
+types=$((origins + `padded $((4 * noStates))`))
+
+# corrupt <name> <offset> <bytes>: writes the bytes (printf escapes) into a
+# copy of the snapshot, which has to be rejected
+corrupt() {
+  cp "$DIR/model.imcsnap" "$DIR/$1.imcsnap"
+  printf "$3" | dd of="$DIR/$1.imcsnap" bs=1 seek=$2 conv=notrunc \
+    2> /dev/null
+  "$BIN" -c -i "imcsnap:$DIR/$1.imcsnap" -o "ctmdpi:$DIR/$1.ctmdpi" \
+    > "$DIR/log" 2>&1
+  status=$?
+  if [ $status -eq 0 ] || ! grep -q "Error reading snapshot file" "$DIR/log"
+  then
+    fail "$1 (exit status $status)"
+  fi
+}
+
+corrupt number-out-of-range $((numbers + 1)) '\377\377\377'
+corrupt number-twice $((numbers + 4)) '\001\000\000\000'
+corrupt origin-out-of-range $origins '\000\000\000\001'
+corrupt type-notdec $types '\000'
+corrupt type-markov $((types + 1)) '\001'
+corrupt labels-overflow 24 '\001\000\000\200'
+corrupt transitions-overflow 20 '\001\000\000\200'
+
+if [ $failed -eq 0 ]; then
+  echo "snapshot: all tests passed"
+fi
+exit $failed